@@ -15,43 +15,39 @@
   along with this program.    If not, see <https://www.gnu.org/licenses/>.
 */
 
+#include <csignal>
 #include <iostream>
 
 #include "arg_parser.hpp"
 #include "logging.h"
 
 #include "frame_data_analyser.hpp"
+#include "runtime_features.hpp"
 #include "version.hpp"
 
 class Listener : public EventListener {
 public:
-    void frame_data(FrameDataPoint frame_data) override;
-    void distance(float /*distance*/) override;
-    void status(PlayerState /*status*/) override;
-    void game_hooked() override;
+    void tick(const TickEvents &events) override;
 };
 
-void Listener::frame_data(const FrameDataPoint frame_data) {
+void Listener::tick(const TickEvents &events) {
+    if ((events.changed & TICK_FRAME_DATA) == 0) {
+        return;
+    }
+
+    const FrameDataPoint &frame_data = events.frame_data;
     std::cout << "startup frames: " << frame_data.startup_frames << ", frame advantage: " << frame_data.frame_advantage
               << ", KD: " << frame_data.knock_down << std::endl;
 }
 
-void Listener::distance(const float /*distance*/) {
-    // NOP
-}
-
-void Listener::status(const PlayerState /*status*/) {
-    // NOP
-}
-
-void Listener::game_hooked() {
-    // NOP
-}
-
 namespace {
-void apply_config(Configuration &config) {
-    log_set_level(config.log_level);
-    FrameDataAnalyser::set_logging(config.frame_data_logging);
+/**
+ * Stop the analyser on Ctrl-C or termination so the features are torn down,
+ * a second signal terminates immediately
+ */
+void stop_signal(int signal_number) {
+    FrameDataAnalyser::stop();
+    (void) signal(signal_number, SIG_DFL);
 }
 } // namespace
 
@@ -64,12 +60,16 @@ int main(const int argc, const char **argv) {
         // Early exit
         return 0;
     }
-    apply_config(config);
+    RuntimeFeatures::start(config);
 
     log_info("%s %s", PROGRAM_NAME, VERSION);
 
+    (void) signal(SIGINT, &stop_signal);
+    (void) signal(SIGTERM, &stop_signal);
+
     Listener listener;
     FrameDataAnalyser::start(&listener);
+    RuntimeFeatures::stop();
 
     return 0;
 }
@@ -21,6 +21,8 @@
 
 #include "arg_parser.hpp"
 
+#include "frame_export.h"
+#include "frame_trace.hpp"
 #include "logging.h"
 #include "version.hpp"
 
@@ -44,6 +46,19 @@ Arg ArgParser::s_arguments[] = {
     {.long_form = "--version", .short_form = "\0", .type = ArgType::FLAG, .handler = &arg_print_version},
     {.long_form = "--verbose", .short_form = "-v", .type = ArgType::FLAG, .handler = &arg_verbose},
     {.long_form = "--print-frames", .short_form = "-pf", .type = ArgType::FLAG, .handler = &arg_print_frames},
+    {.long_form = "--async-log", .short_form = "-al", .type = ArgType::FLAG, .handler = &arg_async_log},
+    {.long_form = "--trace-frames", .short_form = "-tf", .type = ArgType::VALUE, .handler = &arg_trace_frames},
+    {.long_form = "--dump-trace", .short_form = "-dt", .type = ArgType::VALUE, .handler = &arg_dump_trace},
+    {.long_form = "--shared-memory", .short_form = "-sm", .type = ArgType::FLAG, .handler = &arg_shared_memory},
+    {.long_form = "--event-socket", .short_form = "-es", .type = ArgType::VALUE, .handler = &arg_event_socket},
+    {.long_form = "--shadow-analyser",
+     .short_form = "-sa",
+     .type = ArgType::VALUE,
+     .handler = &arg_shadow_analyser},
+    {.long_form = "--tick-profile", .short_form = "-tp", .type = ArgType::FLAG, .handler = &arg_tick_profile},
+    {.long_form = "--read-stats", .short_form = "-rs", .type = ArgType::FLAG, .handler = &arg_read_stats},
+    {.long_form = "--span-trace", .short_form = "-st", .type = ArgType::VALUE, .handler = &arg_span_trace},
+    {.long_form = "--perf-counters", .short_form = "-pc", .type = ArgType::FLAG, .handler = &arg_perf_counters},
 };
 
 int ArgParser::arg_print_help(const char * /*value*/) {
@@ -52,6 +67,17 @@ int ArgParser::arg_print_help(const char * /*value*/) {
                      "        --version\t\tprint version\n"
                      "  -v,   --verbose\t\tverbose output\n"
                      "  -pf,  --print-frames\t\tprint frame data\n"
+                     "  -al,  --async-log\t\twrite log messages on a background thread, batched and\n"
+                     "\t\t\t\tordered per thread only\n"
+                     "  -tf,  --trace-frames FILE\twrite binary frame trace to FILE\n"
+                     "  -dt,  --dump-trace FILE\tprint binary frame trace FILE as text\n"
+                     "  -sm,  --shared-memory\t\tpublish live frame data to shared memory " FRAME_EXPORT_NAME "\n"
+                     "  -es,  --event-socket PATH\tstream events as JSON lines on Unix socket PATH\n"
+                     "  -sa,  --shadow-analyser LIB\tcompare analysis with candidate analyser module LIB\n"
+                     "  -tp,  --tick-profile\t\tprofile analyser tick stages, summary on exit\n"
+                     "  -rs,  --read-stats\t\tcollect per-field memory read latencies, summary on exit\n"
+                     "  -st,  --span-trace FILE\twrite analyser and GUI spans to FILE as Chrome trace JSON\n"
+                     "  -pc,  --perf-counters\t\tcount analyser thread CPU events per tick stage\n"
                      "\nTekken 6 frame data tool overlay";
 
     std::cout << "usage: " << s_program_name << " [OPTIONS...]\n" << options << std::endl;
@@ -74,8 +100,72 @@ int ArgParser::arg_print_frames(const char * /*value*/) {
     return 0;
 }
 
+int ArgParser::arg_async_log(const char * /*value*/) {
+    s_configuration->async_logging = true;
+    return 0;
+}
+
+int ArgParser::arg_trace_frames(const char *value) {
+    s_configuration->trace_file = value;
+    return 0;
+}
+
+int ArgParser::arg_dump_trace(const char *value) {
+    if (!FrameTrace::dump(value, stdout)) {
+        return 1;
+    }
+    return -1;
+}
+
+int ArgParser::arg_shared_memory(const char * /*value*/) {
+    s_configuration->shared_memory = true;
+    return 0;
+}
+
+int ArgParser::arg_event_socket(const char *value) {
+    s_configuration->event_socket = value;
+    return 0;
+}
+
+int ArgParser::arg_shadow_analyser(const char *value) {
+    s_configuration->shadow_analyser = value;
+    return 0;
+}
+
+int ArgParser::arg_tick_profile(const char * /*value*/) {
+    s_configuration->tick_profile = true;
+    return 0;
+}
+
+int ArgParser::arg_read_stats(const char * /*value*/) {
+    s_configuration->read_stats = true;
+    return 0;
+}
+
+int ArgParser::arg_span_trace(const char *value) {
+    s_configuration->span_trace = value;
+    return 0;
+}
+
+int ArgParser::arg_perf_counters(const char * /*value*/) {
+    // Counters are aggregated by the tick profiler stages
+    s_configuration->tick_profile = true;
+    s_configuration->perf_counters = true;
+    return 0;
+}
+
 Configuration ArgParser::create_default_config() {
-    return {.log_level = LOG_INFO, .frame_data_logging = false};
+    return {.log_level = LOG_INFO,
+            .frame_data_logging = false,
+            .trace_file = nullptr,
+            .async_logging = false,
+            .shared_memory = false,
+            .event_socket = nullptr,
+            .shadow_analyser = nullptr,
+            .tick_profile = false,
+            .read_stats = false,
+            .span_trace = nullptr,
+            .perf_counters = false};
 }
 
 int ArgParser::parse_arguments(const int argc, const char **argv, Configuration *config) {
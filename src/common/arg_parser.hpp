@@ -23,6 +23,15 @@ struct Arg;
 struct Configuration {
     int log_level;
     bool frame_data_logging;
+    const char *trace_file;
+    bool async_logging;
+    bool shared_memory;
+    const char *event_socket;
+    const char *shadow_analyser;
+    bool tick_profile;
+    bool read_stats;
+    const char *span_trace;
+    bool perf_counters;
 };
 
 class ArgParser {
@@ -35,6 +44,16 @@ private:
     static int arg_print_version(const char * /*value*/);
     static int arg_verbose(const char * /*value*/);
     static int arg_print_frames(const char * /*value*/);
+    static int arg_async_log(const char * /*value*/);
+    static int arg_trace_frames(const char *value);
+    static int arg_dump_trace(const char *value);
+    static int arg_shared_memory(const char * /*value*/);
+    static int arg_event_socket(const char *value);
+    static int arg_shadow_analyser(const char *value);
+    static int arg_tick_profile(const char * /*value*/);
+    static int arg_read_stats(const char * /*value*/);
+    static int arg_span_trace(const char *value);
+    static int arg_perf_counters(const char * /*value*/);
 
 public:
     static Configuration create_default_config();
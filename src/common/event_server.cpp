@@ -0,0 +1,266 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "event_server.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+#include "logging.h"
+
+// Constants
+// Events of about 4 seconds of analyser ticks
+#define EVENT_QUEUE_SIZE 512
+#define EVENT_LINE_SIZE 128
+
+std::atomic<bool> EventServer::m_running = false;
+std::atomic<size_t> EventServer::m_client_count = 0;
+std::atomic<uint32_t> EventServer::m_dropped = 0;
+SpscQueue<QueuedEvents> EventServer::m_queue(EVENT_QUEUE_SIZE);
+QueuedEvents EventServer::m_latest = {};
+std::atomic<uint64_t> EventServer::m_latest_lock = 0;
+std::thread EventServer::m_thread;
+int EventServer::m_listen_fd = -1;
+int EventServer::m_epoll_fd = -1;
+int EventServer::m_wake_fd = -1;
+char EventServer::m_path[108] = {};
+EventClient EventServer::m_clients[EVENT_SERVER_MAX_CLIENTS];
+
+namespace {
+struct EventName {
+    EventType type;
+    const char *name;
+};
+
+constexpr EventName EVENT_NAMES[] = {{.type = EVENT_FRAME_DATA, .name = "frame_data"},
+                                     {.type = EVENT_DISTANCE, .name = "distance"},
+                                     {.type = EVENT_STATUS, .name = "status"},
+                                     {.type = EVENT_HOOK, .name = "hook"},
+                                     {.type = EVENT_RESYNC, .name = "resync"},
+                                     {.type = EVENT_ALL, .name = "all"}};
+
+/**
+ * Split next whitespace separated token in place
+ *
+ * @param cursor parse position, advanced past the token
+ * @return token or nullptr at the end of the line
+ */
+char *next_token(char **cursor) {
+    char *token = *cursor;
+    while (*token == ' ' || *token == '\t' || *token == '\r') {
+        token++;
+    }
+    if (*token == '\0') {
+        return nullptr;
+    }
+
+    char *end = token;
+    while (*end != '\0' && *end != ' ' && *end != '\t' && *end != '\r') {
+        end++;
+    }
+    if (*end != '\0') {
+        *end++ = '\0';
+    }
+    *cursor = end;
+    return token;
+}
+
+bool parse_event_type(const char *name, uint8_t *type) {
+    for (const auto &event_name : EVENT_NAMES) {
+        if (strcmp(name, event_name.name) == 0) {
+            *type = event_name.type;
+            return true;
+        }
+    }
+    return false;
+}
+} // namespace
+
+bool EventServer::enabled() {
+    return m_running.load(std::memory_order_relaxed);
+}
+
+size_t EventServer::client_count() {
+    return m_client_count.load(std::memory_order_relaxed);
+}
+
+void EventServer::publish(const TickEvents &events) {
+    update_latest(events);
+
+    // Nothing is queued without clients, a client counted after this is sent the latest values instead
+    if (m_client_count.load(std::memory_order_seq_cst) == 0) {
+        return;
+    }
+
+    if (!m_queue.push({.sequence = m_latest.sequence, .events = events})) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    wake();
+}
+
+void EventServer::update_latest(const TickEvents &events) {
+    // Seqlock write, odd while updating, the analyser is the only writer
+    const uint64_t lock = m_latest_lock.load(std::memory_order_relaxed);
+    m_latest_lock.store(lock + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    TickEvents &latest = m_latest.events;
+    if ((events.changed & TICK_FRAME_DATA) != 0) {
+        latest.frame_data = events.frame_data;
+    }
+    if ((events.changed & TICK_DISTANCE) != 0) {
+        latest.distance = events.distance;
+    }
+    if ((events.changed & TICK_STATUS) != 0) {
+        latest.status = events.status;
+    }
+    if ((events.changed & TICK_HOOK) != 0) {
+        latest.hooked = events.hooked;
+    }
+    // Resyncs are one-off, not state
+    latest.changed |= events.changed & (uint8_t) ~TICK_RESYNC;
+    m_latest.sequence++;
+
+    // Ordered before the client count check of publish
+    m_latest_lock.store(lock + 2, std::memory_order_seq_cst);
+}
+
+QueuedEvents EventServer::read_latest() {
+    QueuedEvents latest{};
+    uint64_t begin = 0;
+    uint64_t end = 0;
+    do {
+        begin = m_latest_lock.load(std::memory_order_seq_cst);
+        latest = m_latest;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        end = m_latest_lock.load(std::memory_order_relaxed);
+    } while ((begin & 1U) != 0 || begin != end);
+    return latest;
+}
+
+void EventServer::send_snapshot(EventClient &client) {
+    const QueuedEvents latest = read_latest();
+    client.snapshot_sequence = latest.sequence;
+
+    char line[EVENT_LINE_SIZE];
+    for (const auto &event_name : EVENT_NAMES) {
+        if (event_name.type == EVENT_ALL || (latest.events.changed & event_name.type) == 0) {
+            continue;
+        }
+        const int length = format_event(latest.events, event_name.type, line, sizeof(line));
+        send_line(client, line, (size_t) length);
+    }
+}
+
+int EventServer::format_event(const TickEvents &events, const EventType type, char *buffer, const size_t size) {
+    switch (type) {
+    case EVENT_FRAME_DATA:
+        return snprintf(buffer,
+                        size,
+                        "{\"event\":\"frame_data\",\"startup_frames\":%d,\"frame_advantage\":%d,\"knock_down\":%s}\n",
+                        events.frame_data.startup_frames,
+                        events.frame_data.frame_advantage,
+                        events.frame_data.knock_down ? "true" : "false");
+    case EVENT_DISTANCE:
+        return snprintf(buffer, size, "{\"event\":\"distance\",\"distance\":%.3f}\n", events.distance);
+    case EVENT_STATUS:
+        return snprintf(buffer,
+                        size,
+                        "{\"event\":\"status\",\"status\":\"%s\",\"state\":%d}\n",
+                        FrameDataAnalyser::player_status(events.status),
+                        (int) events.status);
+    case EVENT_HOOK:
+        return snprintf(
+            buffer, size, "{\"event\":\"hook\",\"hooked\":%s}\n", events.hooked ? "true" : "false");
+    case EVENT_RESYNC:
+        return snprintf(buffer, size, "{\"event\":\"resync\",\"frames_off\":%d}\n", events.frames_off);
+    default:
+        return 0;
+    }
+}
+
+void EventServer::broadcast_queued() {
+    QueuedEvents queued{};
+    char line[EVENT_LINE_SIZE];
+
+    while (m_queue.pop(queued)) {
+        const TickEvents &events = queued.events;
+        for (const auto &event_name : EVENT_NAMES) {
+            if (event_name.type == EVENT_ALL || (events.changed & event_name.type) == 0) {
+                continue;
+            }
+
+            // Formatted once for all subscribers
+            const int length = format_event(events, event_name.type, line, sizeof(line));
+            for (EventClient &client : m_clients) {
+                if (client.fd >= 0 && (client.subscriptions & event_name.type) != 0 &&
+                    queued.sequence > client.snapshot_sequence) {
+                    send_line(client, line, (size_t) length);
+                }
+            }
+        }
+    }
+
+    for (EventClient &client : m_clients) {
+        if (client.fd >= 0 && client.pending > 0) {
+            flush_client(client);
+        }
+    }
+}
+
+void EventServer::send_line(EventClient &client, const char *line, const size_t length) {
+    if (client.pending + length > sizeof(client.buffer)) {
+        log_warn("dropping slow event client");
+        close_client(client);
+        return;
+    }
+
+    memcpy(&client.buffer[client.pending], line, length); // NOLINT
+    client.pending += length;
+}
+
+void EventServer::handle_command(EventClient &client, char *command) {
+    char *cursor = command;
+    const char *action = next_token(&cursor);
+    if (action == nullptr) {
+        return;
+    }
+
+    const bool subscribe = strcmp(action, "subscribe") == 0;
+    if (!subscribe && strcmp(action, "unsubscribe") != 0) {
+        const char error[] = "{\"event\":\"error\",\"message\":\"unknown command\"}\n";
+        send_line(client, error, sizeof(error) - 1);
+        return;
+    }
+
+    const char *name = nullptr;
+    while ((name = next_token(&cursor)) != nullptr) {
+        uint8_t type = 0;
+        if (!parse_event_type(name, &type)) {
+            const char error[] = "{\"event\":\"error\",\"message\":\"unknown event type\"}\n";
+            send_line(client, error, sizeof(error) - 1);
+            return;
+        }
+
+        if (subscribe) {
+            client.subscriptions |= type;
+        } else {
+            client.subscriptions &= (uint8_t) ~type;
+        }
+    }
+}
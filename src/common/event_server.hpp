@@ -0,0 +1,132 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef EVENT_SERVER_HPP
+#define EVENT_SERVER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+#include "frame_data_analyser.hpp"
+#include "spsc_queue.hpp"
+
+#define EVENT_SERVER_MAX_CLIENTS 16
+// Pending output of a client, clients which fall further behind are dropped
+#define EVENT_CLIENT_BUFFER_SIZE 65536
+#define EVENT_CLIENT_COMMAND_SIZE 256
+
+// Event types clients can subscribe to, same bits as TickEventFlag
+enum EventType : uint8_t {
+    EVENT_FRAME_DATA = TICK_FRAME_DATA,
+    EVENT_DISTANCE = TICK_DISTANCE,
+    EVENT_STATUS = TICK_STATUS,
+    EVENT_HOOK = TICK_HOOK,
+    EVENT_RESYNC = TICK_RESYNC,
+    EVENT_ALL = EVENT_FRAME_DATA | EVENT_DISTANCE | EVENT_STATUS | EVENT_HOOK | EVENT_RESYNC
+};
+
+// Tick events with their publish sequence number
+struct QueuedEvents {
+    uint64_t sequence;
+    TickEvents events;
+};
+
+struct EventClient {
+    int fd;
+    uint8_t subscriptions;
+    // Sequence of the snapshot sent on connect, older queued events are skipped
+    uint64_t snapshot_sequence;
+    bool want_write;
+    size_t pending;
+    size_t command_length;
+    char buffer[EVENT_CLIENT_BUFFER_SIZE];
+    char command[EVENT_CLIENT_COMMAND_SIZE];
+};
+
+/**
+ * Streams analyser events to local clients as newline-delimited JSON
+ *
+ * Clients connect to a Unix domain socket and receive every event type by
+ * default. Lines "subscribe TYPE..." and "unsubscribe TYPE..." change the
+ * subscriptions, types are frame_data, distance, status, hook, resync and all.
+ * A new client first receives the latest hook, status, distance and frame
+ * data, events are sent on change only.
+ */
+class EventServer {
+public:
+    EventServer() = delete;
+    ~EventServer() = delete;
+
+    EventServer(const EventServer &) = delete;
+    EventServer(EventServer &&) = delete;
+    EventServer &operator=(const EventServer &) = delete;
+    EventServer &operator=(EventServer &&) = delete;
+
+    /**
+     * Listen on the socket and start the server thread
+     *
+     * @param path socket path
+     * @return true on success
+     */
+    static bool start(const char *path);
+    static void stop();
+    static bool enabled();
+    static size_t client_count();
+
+    /**
+     * Queue tick events for clients (analyser thread only), never blocks
+     *
+     * @param events tick events
+     */
+    static void publish(const TickEvents &events);
+
+private:
+    static std::atomic<bool> m_running;
+    static std::atomic<size_t> m_client_count;
+    static std::atomic<uint32_t> m_dropped;
+    static SpscQueue<QueuedEvents> m_queue;
+    // Latest value of every event type, written by the analyser under a seqlock
+    static QueuedEvents m_latest;
+    static std::atomic<uint64_t> m_latest_lock;
+    static std::thread m_thread;
+    static int m_listen_fd;
+    static int m_epoll_fd;
+    static int m_wake_fd;
+    static char m_path[108];
+    static EventClient m_clients[EVENT_SERVER_MAX_CLIENTS];
+
+    // Platform specific
+    static void wake();
+    static void server_loop();
+    static void accept_clients();
+    static void close_client(EventClient &client);
+    static void read_commands(EventClient &client);
+    static void flush_client(EventClient &client);
+    static void update_interest(EventClient &client);
+
+    static void update_latest(const TickEvents &events);
+    static QueuedEvents read_latest();
+    static void send_snapshot(EventClient &client);
+    static void handle_command(EventClient &client, char *command);
+    static void broadcast_queued();
+    static int format_event(const TickEvents &events, const EventType type, char *buffer, const size_t size);
+    static void send_line(EventClient &client, const char *line, const size_t length);
+};
+
+#endif
@@ -0,0 +1,318 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "event_server.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "logging.h"
+
+// Constants
+#define EVENT_LISTEN_BACKLOG 4
+#define EVENT_MAX_EPOLL_EVENTS (EVENT_SERVER_MAX_CLIENTS + 2)
+// Epoll tags of the listening socket and the wake eventfd, clients use their index
+#define EPOLL_TAG_LISTEN UINT32_MAX
+#define EPOLL_TAG_WAKE (UINT32_MAX - 1)
+
+namespace {
+/**
+ * Remove a socket file left by a previous run, other files are never removed
+ *
+ * @param path socket path
+ * @return true if nothing is left at the path
+ */
+bool remove_socket_file(const char *path) {
+    struct stat status = {};
+    if (lstat(path, &status) != 0) {
+        return errno == ENOENT;
+    }
+
+    if (!S_ISSOCK(status.st_mode)) {
+        log_error("event socket path \"%s\" exists and is not a socket", path);
+        return false;
+    }
+
+    if (unlink(path) != 0) {
+        log_error("failed to remove stale event socket \"%s\"", path);
+        return false;
+    }
+    return true;
+}
+} // namespace
+
+bool EventServer::start(const char *path) {
+    if (m_running) {
+        return true;
+    }
+
+    for (EventClient &client : m_clients) {
+        client.fd = -1;
+    }
+
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(address.sun_path) || strlen(path) >= sizeof(m_path)) {
+        log_error("event socket path \"%s\" is too long", path);
+        return false;
+    }
+    strcpy(address.sun_path, path); // NOLINT
+    strcpy(m_path, path); // NOLINT
+
+    if (!remove_socket_file(m_path)) {
+        return false;
+    }
+
+    // Snapshot for new clients starts empty
+    m_latest = {};
+    m_latest_lock = 0;
+
+    m_listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (m_listen_fd < 0) {
+        log_error("failed to create event socket");
+        return false;
+    }
+
+    if (bind(m_listen_fd, (const sockaddr *) &address, sizeof(address)) != 0 ||
+        listen(m_listen_fd, EVENT_LISTEN_BACKLOG) != 0) {
+        log_error("failed to listen on event socket \"%s\"", path);
+        close(m_listen_fd);
+        m_listen_fd = -1;
+        return false;
+    }
+
+    m_wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    m_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (m_wake_fd < 0 || m_epoll_fd < 0) {
+        log_error("failed to create event server epoll");
+        stop();
+        return false;
+    }
+
+    epoll_event event = {.events = EPOLLIN, .data = {.u32 = EPOLL_TAG_LISTEN}};
+    epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, m_listen_fd, &event);
+    event = {.events = EPOLLIN, .data = {.u32 = EPOLL_TAG_WAKE}};
+    epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, m_wake_fd, &event);
+
+    m_dropped = 0;
+    m_running = true;
+    m_thread = std::thread(&server_loop);
+
+    log_info("streaming events on \"%s\"", path);
+    return true;
+}
+
+void EventServer::stop() {
+    if (m_listen_fd < 0) {
+        return;
+    }
+
+    if (m_running) {
+        m_running = false;
+        wake();
+        m_thread.join();
+    }
+
+    for (EventClient &client : m_clients) {
+        if (client.fd >= 0) {
+            close_client(client);
+        }
+    }
+
+    if (m_listen_fd >= 0) {
+        close(m_listen_fd);
+        m_listen_fd = -1;
+        (void) remove_socket_file(m_path);
+    }
+    if (m_epoll_fd >= 0) {
+        close(m_epoll_fd);
+        m_epoll_fd = -1;
+    }
+    if (m_wake_fd >= 0) {
+        close(m_wake_fd);
+        m_wake_fd = -1;
+    }
+
+    if (m_dropped > 0) {
+        log_warn("event server dropped %u ticks", m_dropped.load());
+    }
+}
+
+void EventServer::wake() {
+    const uint64_t value = 1;
+    (void) !write(m_wake_fd, &value, sizeof(value));
+}
+
+void EventServer::server_loop() {
+    epoll_event events[EVENT_MAX_EPOLL_EVENTS];
+
+    while (m_running) {
+        const int count = epoll_wait(m_epoll_fd, events, EVENT_MAX_EPOLL_EVENTS, -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            log_error("event server epoll failed");
+            break;
+        }
+
+        for (int i = 0; i < count; i++) {
+            const uint32_t tag = events[i].data.u32; // NOLINT
+            if (tag == EPOLL_TAG_LISTEN) {
+                accept_clients();
+            } else if (tag == EPOLL_TAG_WAKE) {
+                uint64_t value = 0;
+                (void) !read(m_wake_fd, &value, sizeof(value));
+            } else {
+                EventClient &client = m_clients[tag]; // NOLINT
+                if (client.fd < 0) {
+                    continue;
+                }
+                if ((events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) != 0) { // NOLINT
+                    read_commands(client);
+                }
+                if (client.fd >= 0 && (events[i].events & EPOLLOUT) != 0) { // NOLINT
+                    flush_client(client);
+                }
+            }
+        }
+
+        broadcast_queued();
+    }
+}
+
+void EventServer::accept_clients() {
+    int fd = -1;
+    while ((fd = accept4(m_listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+        EventClient *client = nullptr;
+        uint32_t index = 0;
+        for (; index < EVENT_SERVER_MAX_CLIENTS; index++) {
+            if (m_clients[index].fd < 0) { // NOLINT
+                client = &m_clients[index]; // NOLINT
+                break;
+            }
+        }
+
+        if (client == nullptr) {
+            log_warn("event server is full, rejecting client");
+            close(fd);
+            continue;
+        }
+
+        client->fd = fd;
+        client->subscriptions = EVENT_ALL;
+        client->want_write = false;
+        client->pending = 0;
+        client->command_length = 0;
+
+        // Counted before the snapshot is taken, so every later tick is queued
+        m_client_count.fetch_add(1, std::memory_order_seq_cst);
+        send_snapshot(*client);
+
+        epoll_event event = {.events = EPOLLIN, .data = {.u32 = index}};
+        epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, fd, &event);
+        log_debug("event client connected");
+    }
+}
+
+void EventServer::close_client(EventClient &client) {
+    if (m_epoll_fd >= 0) {
+        epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, client.fd, nullptr);
+    }
+    close(client.fd);
+    client.fd = -1;
+    m_client_count.fetch_sub(1, std::memory_order_relaxed);
+    log_debug("event client disconnected");
+}
+
+void EventServer::read_commands(EventClient &client) {
+    while (true) {
+        char *free_space = &client.command[client.command_length]; // NOLINT
+        const size_t free_size = sizeof(client.command) - client.command_length;
+        const ssize_t length = read(client.fd, free_space, free_size);
+        if (length == 0 || (length < 0 && errno != EAGAIN && errno != EINTR)) {
+            close_client(client);
+            return;
+        }
+        if (length < 0) {
+            return;
+        }
+        client.command_length += length;
+
+        // Handle complete lines, keep the partial tail
+        size_t start = 0;
+        for (size_t i = 0; i < client.command_length; i++) {
+            if (client.command[i] == '\n') { // NOLINT
+                client.command[i] = '\0'; // NOLINT
+                handle_command(client, &client.command[start]); // NOLINT
+                if (client.fd < 0) {
+                    return;
+                }
+                start = i + 1;
+            }
+        }
+        client.command_length -= start;
+        memmove(client.command, &client.command[start], client.command_length); // NOLINT
+
+        if (client.command_length == sizeof(client.command)) {
+            log_warn("event client command is too long");
+            close_client(client);
+            return;
+        }
+    }
+}
+
+void EventServer::flush_client(EventClient &client) {
+    while (client.pending > 0) {
+        const ssize_t length = send(client.fd, client.buffer, client.pending, MSG_NOSIGNAL);
+        if (length < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno != EAGAIN) {
+                close_client(client);
+                return;
+            }
+            break;
+        }
+
+        client.pending -= length;
+        memmove(client.buffer, &client.buffer[length], client.pending); // NOLINT
+    }
+
+    update_interest(client);
+}
+
+void EventServer::update_interest(EventClient &client) {
+    // Wait for writability only while output is pending
+    const bool want_write = client.pending > 0;
+    if (want_write == client.want_write) {
+        return;
+    }
+
+    const auto index = (uint32_t) (&client - m_clients);
+    epoll_event event = {.events = EPOLLIN | (want_write ? EPOLLOUT : 0U), .data = {.u32 = index}};
+    epoll_ctl(m_epoll_fd, EPOLL_CTL_MOD, client.fd, &event);
+    client.want_write = want_write;
+}
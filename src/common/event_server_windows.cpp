@@ -0,0 +1,43 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "event_server.hpp"
+
+#include "logging.h"
+
+bool EventServer::start(const char *path) {
+    log_error("event socket \"%s\" is not supported on Windows", path);
+    return false;
+}
+
+void EventServer::stop() {}
+
+void EventServer::wake() {}
+
+void EventServer::server_loop() {}
+
+void EventServer::accept_clients() {}
+
+void EventServer::close_client(EventClient &client) {
+    client.fd = -1;
+}
+
+void EventServer::read_commands(EventClient &client) {}
+
+void EventServer::flush_client(EventClient &client) {}
+
+void EventServer::update_interest(EventClient &client) {}
@@ -17,11 +17,11 @@
 
 #include "ring_buffer.hpp"
 
+#include <array>
 #include <chrono>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
-#include <sstream>
 #include <thread>
 
 #include "game_state_reader.h"
@@ -29,94 +29,150 @@
 #include "memory_reader_types.h"
 
 #include "frame_data_analyser.hpp"
+#include "event_server.hpp"
+#include "frame_exporter.hpp"
+#include "frame_trace.hpp"
+#include "lookup_tables.hpp"
+#include "perf_counters.hpp"
+#include "shadow_analyser.hpp"
+#include "span_tracer.hpp"
+#include "tick_profiler.hpp"
 
 // Constants
 
-// Run the tool twice as fast as the game to get accurate measurements
-#define TICK_LENGTH 8333333
-
 // Ten seconds of frames
 #define FRAME_BUFFER_SIZE (size_t) (60 * 10)
 #define PLAYER_ACTION_BUFFER_SIZE 10
 #define PLAYER_STRING_BUFFER_SIZE 50
 #define PLAYER_STRING_END_BUFFER_SIZE 4
+// Smallest distance change reported to the listener
+#define DISTANCE_EPSILON 0.001F
+
+namespace {
+// Player state and intent classification
+enum class StatusClass : uint8_t {
+    STANDING,
+    CROUCH,
+    CROUCHING,
+    JUMPING,
+    AIRBORNE,
+    GROUNDED,
+    UNDETERMINABLE
+};
+
+constexpr const char *STATUS_NAMES[] = {
+    "Standing", "Crouch", "Crouching", "Jumping", "Airborne", "Grounded", "Undeterminable"};
+
+enum class IntentClass : uint8_t {
+    ATTACK,
+    NOT_ATTACK,
+    UNKNOWN
+};
+
+template<typename E, typename V>
+constexpr LookupEntry<V> entry(const E key, const V value) {
+    return {.key = (int32_t) key, .value = value};
+}
+
+constexpr auto STATUS_ENTRIES = std::to_array({
+    entry(PlayerState::STANDING, StatusClass::STANDING),
+    entry(PlayerState::MOVE_BACKWARDS, StatusClass::STANDING),
+    entry(PlayerState::MOVE_FORWARDS, StatusClass::STANDING),
+    entry(PlayerState::DASH_BACKWARDS, StatusClass::STANDING),
+    entry(PlayerState::DASH_FORWARDS, StatusClass::STANDING),
+    entry(PlayerState::MOVE, StatusClass::STANDING),
+    entry(PlayerState::RECOVER1, StatusClass::STANDING),
+    entry(PlayerState::RECOVER2, StatusClass::STANDING),
+    entry(PlayerState::STRING, StatusClass::STANDING),
+    entry(PlayerState::STANDING_HIT, StatusClass::STANDING),
+    entry(PlayerState::CROUCH_DASH_JUMP, StatusClass::STANDING),
+    entry(PlayerState::POWER_STANCE, StatusClass::STANDING),
+    entry(PlayerState::SPINNING1, StatusClass::STANDING),
+    entry(PlayerState::SPINNING2, StatusClass::STANDING),
+    entry(PlayerState::SPIN_TO_STANDUP, StatusClass::STANDING),
+    entry(PlayerState::TRANSITION1, StatusClass::STANDING),
+    entry(PlayerState::TRANSITION2, StatusClass::STANDING),
+    entry(PlayerState::UNBLOCKABLE1, StatusClass::STANDING),
+    entry(PlayerState::UNBLOCKABLE2, StatusClass::STANDING),
+    entry(PlayerState::SLIDE1, StatusClass::STANDING),
+    entry(PlayerState::SLIDE2, StatusClass::STANDING),
+    entry(PlayerState::STAND_SWORD, StatusClass::STANDING),
+    entry(PlayerState::CROUCH, StatusClass::CROUCH),
+    entry(PlayerState::SITTING, StatusClass::CROUCH),
+    entry(PlayerState::CROUCHING, StatusClass::CROUCHING),
+    entry(PlayerState::CROUCHING_ATTACK, StatusClass::CROUCHING),
+    entry(PlayerState::CROUCHING_BACKWARDS, StatusClass::CROUCHING),
+    entry(PlayerState::CROUCHING_FORWARDS, StatusClass::CROUCHING),
+    entry(PlayerState::JUMPING, StatusClass::JUMPING),
+    entry(PlayerState::JUMPING_FORWARDS, StatusClass::JUMPING),
+    entry(PlayerState::JUMPING_BACKWARDS, StatusClass::JUMPING),
+    entry(PlayerState::AIRBORNE, StatusClass::AIRBORNE),
+    entry(PlayerState::GROUNDED1, StatusClass::GROUNDED),
+    entry(PlayerState::GROUNDED2, StatusClass::GROUNDED),
+});
+
+constexpr auto INTENT_ENTRIES = std::to_array({
+    entry(PlayerIntent::ATTACK1, IntentClass::ATTACK),
+    entry(PlayerIntent::ATTACK3, IntentClass::ATTACK),
+    entry(PlayerIntent::ATTACK5, IntentClass::ATTACK),
+    entry(PlayerIntent::ATTACK7, IntentClass::ATTACK),
+    entry(PlayerIntent::IDLE, IntentClass::NOT_ATTACK),
+    entry(PlayerIntent::INPUT_BUFFERING, IntentClass::NOT_ATTACK),
+    entry(PlayerIntent::BLOCK, IntentClass::NOT_ATTACK),
+    entry(PlayerIntent::WALK, IntentClass::NOT_ATTACK),
+    entry(PlayerIntent::SIDE_STEP, IntentClass::NOT_ATTACK),
+    entry(PlayerIntent::DOUBLE_SIDE_STEP, IntentClass::NOT_ATTACK),
+    entry(PlayerIntent::FALLING, IntentClass::NOT_ATTACK),
+    entry(PlayerIntent::LANDING, IntentClass::NOT_ATTACK),
+    entry(PlayerIntent::STASIS, IntentClass::NOT_ATTACK),
+    entry(PlayerIntent::WHIFF, IntentClass::NOT_ATTACK),
+    entry(PlayerIntent::GRAP_INIT, IntentClass::NOT_ATTACK),
+    entry(PlayerIntent::GRAP_CONNECT, IntentClass::NOT_ATTACK),
+    entry(PlayerIntent::SIDE_ROLLING, IntentClass::NOT_ATTACK),
+});
+
+constexpr PerfectHashTable<StatusClass, STATUS_ENTRIES.size()> STATUS_TABLE(STATUS_ENTRIES,
+                                                                            StatusClass::UNDETERMINABLE);
+constexpr PerfectHashTable<IntentClass, INTENT_ENTRIES.size()> INTENT_TABLE(INTENT_ENTRIES, IntentClass::UNKNOWN);
+} // namespace
+
+PlayerAnalysisState::PlayerAnalysisState() :
+    start_frames(PLAYER_ACTION_BUFFER_SIZE),
+    str_connection_frames(PLAYER_STRING_BUFFER_SIZE),
+    str_end_frames(PLAYER_STRING_END_BUFFER_SIZE),
+    str_type_frames(PLAYER_ACTION_BUFFER_SIZE) {}
 
 //// frame_data_analyser
 ///
 volatile bool FrameDataAnalyser::m_stop = false;
 RingBuffer<GameFrame> FrameDataAnalyser::m_frame_buffer(FRAME_BUFFER_SIZE);
-RingBuffer<StartFrame> FrameDataAnalyser::m_p1_start_frames(PLAYER_ACTION_BUFFER_SIZE);
-RingBuffer<StartFrame> FrameDataAnalyser::m_p2_start_frames(PLAYER_ACTION_BUFFER_SIZE);
-RingBuffer<GameFrame> FrameDataAnalyser::m_p1_str_connection_frames(PLAYER_STRING_BUFFER_SIZE);
-RingBuffer<GameFrame> FrameDataAnalyser::m_p2_str_connection_frames(PLAYER_STRING_BUFFER_SIZE);
-RingBuffer<GameFrame> FrameDataAnalyser::m_p1_str_end_frames(PLAYER_STRING_END_BUFFER_SIZE);
-RingBuffer<GameFrame> FrameDataAnalyser::m_p2_str_end_frames(PLAYER_STRING_END_BUFFER_SIZE);
-RingBuffer<GameFrame> FrameDataAnalyser::m_p1_str_type_frames(PLAYER_ACTION_BUFFER_SIZE);
-RingBuffer<GameFrame> FrameDataAnalyser::m_p2_str_type_frames(PLAYER_ACTION_BUFFER_SIZE);
+PlayerAnalysisState FrameDataAnalyser::m_p1_state;
+PlayerAnalysisState FrameDataAnalyser::m_p2_state;
 
 EventListener *FrameDataAnalyser::m_listener = nullptr;
+TickEvents FrameDataAnalyser::m_tick_events = {};
+float FrameDataAnalyser::m_last_distance = -1;
+int32_t FrameDataAnalyser::m_last_status = -1;
 
 // Avoid log spam
-int FrameDataAnalyser::m_last_player_intent = 0;
+UnknownIdCounter<UNKNOWN_ID_TABLE_SIZE> FrameDataAnalyser::m_unknown_states;
+UnknownIdCounter<UNKNOWN_ID_TABLE_SIZE> FrameDataAnalyser::m_unknown_intents;
 bool FrameDataAnalyser::m_logging = false;
 
 void FrameDataAnalyser::log_frame() {
-    const GameFrame *const state = m_frame_buffer.head();
-    std::stringstream stream;
-    stream << "FRAME: " << state->game_frame << std::endl
-           << "P1 last action: " << state->p1.frames_last_action << std::endl
-           << "P1 recovery frames: " << state->p1.recovery_frames << std::endl
-           << "P1 connection: " << (bool) state->p1.connection << std::endl
-           << "P1 intent: " << state->p1.intent << std::endl
-           << "P1 move: " << state->p1.move << std::endl
-           << "P1 state: " << state->p1.state << std::endl
-           << "P1 string type: " << state->p1.string_type << std::endl
-           << "P1 string state: " << state->p1.string_state << std::endl
-           << "P1 position: " << state->p1.position.x << ", " << state->p1.position.y << ", " << state->p1.position.z
-           << std::endl
-           << "P1 attack seq: " << state->p1.attack_seq << std::endl
-           << "P2 last action: " << state->p2.frames_last_action << std::endl
-           << "P2 recovery frames: " << state->p2.recovery_frames << std::endl
-           << "P2 connection: " << (bool) state->p2.connection << std::endl
-           << "P2 intent: " << state->p2.intent << std::endl
-           << "P2 move: " << state->p2.move << std::endl
-           << "P2 state: " << state->p2.state << std::endl
-           << "P2 string type: " << state->p2.string_type << std::endl
-           << "P2 string state: " << state->p2.string_state << std::endl
-           << "P2 position: " << state->p2.position.x << ", " << state->p2.position.y << ", " << state->p2.position.z
-           << std::endl
-           << "P2 attack seq: " << state->p2.attack_seq;
-
-    log_info(stream.str().c_str());
+    char text[FRAME_TEXT_SIZE];
+    FrameTrace::format(*m_frame_buffer.head(), text, sizeof(text));
+    log_info("%s", text);
 }
 
 bool FrameDataAnalyser::is_attack(const PlayerIntent &intent) {
-    switch (intent) {
-    case PlayerIntent::ATTACK1:
-    case PlayerIntent::ATTACK3:
-    case PlayerIntent::ATTACK5:
-    case PlayerIntent::ATTACK7:
-        return true;
-
-    case PlayerIntent::IDLE:
-    case PlayerIntent::INPUT_BUFFERING:
-    case PlayerIntent::BLOCK:
-    case PlayerIntent::WALK:
-    case PlayerIntent::SIDE_STEP:
-    case PlayerIntent::DOUBLE_SIDE_STEP:
-    case PlayerIntent::FALLING:
-    case PlayerIntent::LANDING:
-    case PlayerIntent::STASIS:
-    case PlayerIntent::WHIFF:
-    case PlayerIntent::GRAP_INIT:
-    case PlayerIntent::GRAP_CONNECT:
-    case PlayerIntent::SIDE_ROLLING:
-        return false;
+    const IntentClass intent_class = INTENT_TABLE.get((int32_t) intent);
 
-    default:
+    if (intent_class == IntentClass::UNKNOWN && m_unknown_intents.record((int32_t) intent)) {
         log_warn("unknown player intent \"%i\"", intent);
-        return false;
     }
+
+    return intent_class == IntentClass::ATTACK;
 }
 
 bool FrameDataAnalyser::recovery_reset(const PlayerFrame *const previous, const PlayerFrame *const current) {
@@ -136,70 +192,78 @@ const GameFrame *FrameDataAnalyser::get_game_frame(const uint32_t game_frame) {
 }
 
 const char *FrameDataAnalyser::player_status(const PlayerState state) {
-    static const char STANDING[] = "Standing";
-    static const char CROUCH[] = "Crouch";
-    static const char CROUCHING[] = "Crouching";
-    static const char JUMPING[] = "Jumping";
-    static const char AIRBORNE[] = "Airborne";
-    static const char GROUNDED[] = "Grounded";
-    static const char UNDETERMINABLE[] = "Undeterminable";
-
-    switch (state) {
-    case PlayerState::STANDING:
-    case PlayerState::MOVE_BACKWARDS:
-    case PlayerState::MOVE_FORWARDS:
-    case PlayerState::DASH_BACKWARDS:
-    case PlayerState::DASH_FORWARDS:
-    case PlayerState::MOVE:
-    case PlayerState::RECOVER1:
-    case PlayerState::RECOVER2:
-    case PlayerState::STRING:
-    case PlayerState::STANDING_HIT:
-    case PlayerState::CROUCH_DASH_JUMP:
-    case PlayerState::POWER_STANCE:
-    case PlayerState::SPINNING1:
-    case PlayerState::SPINNING2:
-    case PlayerState::SPIN_TO_STANDUP:
-    case PlayerState::TRANSITION1:
-    case PlayerState::TRANSITION2:
-    case PlayerState::UNBLOCKABLE1:
-    case PlayerState::UNBLOCKABLE2:
-    case PlayerState::SLIDE1:
-    case PlayerState::SLIDE2:
-    case PlayerState::STAND_SWORD:
-        return STANDING;
-    case PlayerState::CROUCH:
-    case PlayerState::SITTING:
-        return CROUCH;
-    case PlayerState::CROUCHING:
-    case PlayerState::CROUCHING_ATTACK:
-    case PlayerState::CROUCHING_BACKWARDS:
-    case PlayerState::CROUCHING_FORWARDS:
-        return CROUCHING;
-    case PlayerState::JUMPING:
-    case PlayerState::JUMPING_FORWARDS:
-    case PlayerState::JUMPING_BACKWARDS:
-        return JUMPING;
-    case PlayerState::AIRBORNE:
-        return AIRBORNE;
-    case PlayerState::GROUNDED1:
-    case PlayerState::GROUNDED2:
-        return GROUNDED;
-    }
-
-    if (m_last_player_intent != (int) state) {
+    const StatusClass status_class = STATUS_TABLE.get((int32_t) state);
+
+    if (status_class == StatusClass::UNDETERMINABLE && m_unknown_states.record((int32_t) state)) {
         log_debug("unknown player status %d", state);
-        m_last_player_intent = (int) state;
     }
 
-    return UNDETERMINABLE;
+    return STATUS_NAMES[(size_t) status_class];
+}
+
+void FrameDataAnalyser::dump_unknown_ids() {
+    for (size_t i = 0; i < m_unknown_states.size(); i++) {
+        log_info("unknown player status %d seen %u times", m_unknown_states.id(i), m_unknown_states.hits(i));
+    }
+    if (m_unknown_states.untracked_sightings() > 0) {
+        log_info("%u untracked sightings of unknown player statuses", m_unknown_states.untracked_sightings());
+    }
+
+    for (size_t i = 0; i < m_unknown_intents.size(); i++) {
+        log_info("unknown player intent %d seen %u times", m_unknown_intents.id(i), m_unknown_intents.hits(i));
+    }
+    if (m_unknown_intents.untracked_sightings() > 0) {
+        log_info("%u untracked sightings of unknown player intents", m_unknown_intents.untracked_sightings());
+    }
 }
 
 bool FrameDataAnalyser::initiated_attack(const PlayerFrame *const previous, const PlayerFrame *const current) {
     return previous->attack_seq != current->attack_seq;
 }
 
+template<Player P>
+PlayerAnalysisState *FrameDataAnalyser::side_state() {
+    if constexpr (P == Player::P1) {
+        return &m_p1_state;
+    } else {
+        return &m_p2_state;
+    }
+}
+
+template<Player P>
+const PlayerFrame *FrameDataAnalyser::player_frame(const GameFrame *const frame) {
+    if constexpr (P == Player::P1) {
+        return &frame->p1;
+    } else {
+        return &frame->p2;
+    }
+}
+
+template<Player P>
+const PlayerFrame *FrameDataAnalyser::opponent_frame(const GameFrame *const frame) {
+    return player_frame<opponent(P)>(frame);
+}
+
+template<Player P>
+void FrameDataAnalyser::mark_start_frame(const GameFrame *const previous, const GameFrame *const current) {
+    const PlayerFrame *const player = player_frame<P>(current);
+
+    if (!initiated_attack(player_frame<P>(previous), player)) {
+        return;
+    }
+
+    side_state<P>()->start_frames.push({.index = m_frame_buffer.head_index(),
+                                        .recovery_frames = player->recovery_frames,
+                                        .game_frame = current->game_frame,
+                                        .attack_seq = player->attack_seq,
+                                        .is_string = string_is_active(player)});
+    if (m_logging) {
+        log_info("MARK STARTUP P%i: %i", (int) P + 1, current->game_frame);
+    }
+}
+
 void FrameDataAnalyser::analyse_start_frames() {
+    TRACE_SCOPE("start frames");
     const GameFrame *const current = m_frame_buffer.head();
     const GameFrame *const previous = m_frame_buffer.get_from_head(1);
 
@@ -207,29 +271,9 @@ void FrameDataAnalyser::analyse_start_frames() {
         return;
     }
 
-    // Check if P1 initiated attack
-    if (initiated_attack(&previous->p1, &current->p1)) {
-        m_p1_start_frames.push({.index = m_frame_buffer.head_index(),
-                                .recovery_frames = current->p1.recovery_frames,
-                                .game_frame = current->game_frame,
-                                .attack_seq = current->p1.attack_seq,
-                                .is_string = string_is_active(&current->p1)});
-        if (m_logging) {
-            log_info("MARK STARTUP P1: %i", current->game_frame);
-        }
-    }
-
-    // Check if P2 initiated attack
-    if (initiated_attack(&previous->p2, &current->p2)) {
-        m_p2_start_frames.push({.index = m_frame_buffer.head_index(),
-                                .recovery_frames = current->p2.recovery_frames,
-                                .game_frame = current->game_frame,
-                                .attack_seq = current->p2.attack_seq,
-                                .is_string = string_is_active(&current->p2)});
-        if (m_logging) {
-            log_info("MARK STARTUP P2: %i", current->game_frame);
-        }
-    }
+    // Check if either player initiated attack
+    mark_start_frame<Player::P1>(previous, current);
+    mark_start_frame<Player::P2>(previous, current);
 }
 
 ConnectionEvent FrameDataAnalyser::has_new_connection() {
@@ -253,9 +297,10 @@ bool FrameDataAnalyser::player_in_stasis(const PlayerFrame *const player_frame)
     return (PlayerIntent) player_frame->intent == PlayerIntent::STASIS;
 }
 
-StartFrame FrameDataAnalyser::get_startup_frame(const GameFrame *const frame, const bool p2, const bool pop) {
-    RingBuffer<StartFrame> *buffer = p2 ? &m_p2_start_frames : &m_p1_start_frames;
-    const int32_t last_attack_seq = p2 ? frame->p2.attack_seq : frame->p1.attack_seq;
+template<Player P>
+StartFrame FrameDataAnalyser::get_startup_frame(const GameFrame *const frame, const bool pop) {
+    RingBuffer<StartFrame> *const buffer = &side_state<P>()->start_frames;
+    const int32_t last_attack_seq = player_frame<P>(frame)->attack_seq;
 
     const size_t item_count = buffer->item_count();
     for (size_t i = 0; i < item_count; i++) {
@@ -293,8 +338,9 @@ bool FrameDataAnalyser::is_knockdown(const PlayerFrame *const player_frame) {
            (PlayerState) player_frame->state == PlayerState::GROUNDED2;
 }
 
-bool FrameDataAnalyser::has_string_startup(const bool p2) {
-    RingBuffer<StartFrame> *const startup_frames = p2 ? &m_p2_start_frames : &m_p1_start_frames;
+template<Player P>
+bool FrameDataAnalyser::has_string_startup() {
+    const RingBuffer<StartFrame> *const startup_frames = &side_state<P>()->start_frames;
     const size_t count = startup_frames->item_count();
     for (size_t i = 0; i < count; i++) {
         if (startup_frames->get(i)->is_string) {
@@ -304,8 +350,9 @@ bool FrameDataAnalyser::has_string_startup(const bool p2) {
     return false;
 }
 
-bool FrameDataAnalyser::should_handle_string(const PlayerFrame *const player_frame, const bool p2) {
-    return string_is_active(player_frame) || has_string_startup(p2);
+template<Player P>
+bool FrameDataAnalyser::should_handle_string(const PlayerFrame *const player_frame) {
+    return string_is_active(player_frame) || has_string_startup<P>();
 }
 
 bool FrameDataAnalyser::string_has_ended_state(const PlayerFrame *player_frame) {
@@ -313,10 +360,11 @@ bool FrameDataAnalyser::string_has_ended_state(const PlayerFrame *player_frame)
     return (StringState) player_frame->string_state == StringState::ENDED;
 }
 
-bool FrameDataAnalyser::string_has_concluded(const GameFrame *current, const bool p2) {
-    RingBuffer<GameFrame> *const str_end_frames = p2 ? &m_p2_str_end_frames : &m_p1_str_end_frames;
-    RingBuffer<GameFrame> *const connection_frames = p2 ? &m_p2_str_connection_frames : &m_p1_str_connection_frames;
-    const GameFrame *const connection = connection_frames->head();
+template<Player P>
+bool FrameDataAnalyser::string_has_concluded(const GameFrame *current) {
+    PlayerAnalysisState *const state = side_state<P>();
+    RingBuffer<GameFrame> *const str_end_frames = &state->str_end_frames;
+    const GameFrame *const connection = state->str_connection_frames.head();
 
     str_end_frames->push(*current);
 
@@ -342,22 +390,13 @@ bool FrameDataAnalyser::string_has_concluded(const GameFrame *current, const boo
 }
 
 void FrameDataAnalyser::reset_string_sm() {
-    // Clear connections
-    m_p1_str_connection_frames.clear();
-    m_p2_str_connection_frames.clear();
-    // Clear end frames
-    m_p1_str_end_frames.clear();
-    m_p2_str_end_frames.clear();
-    // Clear string type frames
-    m_p1_str_type_frames.clear();
-    m_p2_str_type_frames.clear();
-}
-
-void FrameDataAnalyser::push_string_type(const GameFrame *const frame, const bool p2) {
-    if (p2) {
-        m_p2_str_type_frames.push(*frame);
-    } else {
-        m_p1_str_type_frames.push(*frame);
+    for (PlayerAnalysisState *const state : {&m_p1_state, &m_p2_state}) {
+        // Clear connections
+        state->str_connection_frames.clear();
+        // Clear end frames
+        state->str_end_frames.clear();
+        // Clear string type frames
+        state->str_type_frames.clear();
     }
 }
 
@@ -372,9 +411,11 @@ bool FrameDataAnalyser::is_multihit_attack(const PlayerFrame *const player) {
     }
 }
 
-bool FrameDataAnalyser::string_is_multihit_attack(RingBuffer<GameFrame> *const player_connections, const bool p2) {
-    RingBuffer<GameFrame> const *const type_frames = p2 ? &m_p2_str_type_frames : &m_p1_str_type_frames;
-    const GameFrame *const first_connection = player_connections->tail();
+template<Player P>
+bool FrameDataAnalyser::string_is_multihit_attack() {
+    const PlayerAnalysisState *const state = side_state<P>();
+    const RingBuffer<GameFrame> *const type_frames = &state->str_type_frames;
+    const GameFrame *const first_connection = state->str_connection_frames.tail();
     const GameFrame *const first_previous_frame = get_game_frame(first_connection->game_frame - 1);
 
     if (first_previous_frame == nullptr) {
@@ -382,7 +423,7 @@ bool FrameDataAnalyser::string_is_multihit_attack(RingBuffer<GameFrame> *const p
         return false;
     }
 
-    StartFrame last_startup = get_startup_frame(first_previous_frame, p2, false);
+    StartFrame last_startup = get_startup_frame<P>(first_previous_frame, false);
     for (size_t i = 0; i < type_frames->item_count(); i++) {
         const GameFrame *const type_frame = type_frames->get(i);
         if (type_frame->game_frame > last_startup.game_frame) {
@@ -393,7 +434,9 @@ bool FrameDataAnalyser::string_is_multihit_attack(RingBuffer<GameFrame> *const p
     return false;
 }
 
-bool FrameDataAnalyser::calculate_multihit_string(RingBuffer<GameFrame> *const player_connections, const bool p2) {
+template<Player P>
+bool FrameDataAnalyser::get_string_startups(StartFrame *first_startup, StartFrame *last_startup) {
+    const RingBuffer<GameFrame> *const player_connections = &side_state<P>()->str_connection_frames;
     const GameFrame *const first_connection = player_connections->tail();
     const GameFrame *const first_previous_frame = get_game_frame(first_connection->game_frame - 1);
     const GameFrame *const last_connection = player_connections->head();
@@ -401,201 +444,163 @@ bool FrameDataAnalyser::calculate_multihit_string(RingBuffer<GameFrame> *const p
 
     if (first_previous_frame == nullptr) {
         log_error("cannot find previous frame for startup");
-        reset_string_sm();
         return false;
     }
 
     if (last_previous_frame == nullptr) {
         log_error("cannot find previous frame for connection");
-        reset_string_sm();
         return false;
     }
 
-    const StartFrame first_startup = get_startup_frame(first_previous_frame, p2, true);
-    if (first_startup.game_frame == 0) {
+    *first_startup = get_startup_frame<P>(first_previous_frame, true);
+    if (first_startup->game_frame == 0) {
         log_error("Player start up buffer has invalid state (cannot get first)");
-        reset_string_sm();
         return false;
     }
 
     // Check if first and last are the same
-    StartFrame last_startup{};
-
     if (first_connection->game_frame == last_connection->game_frame) {
-        last_startup = first_startup;
-    } else {
-        last_startup = get_startup_frame(last_previous_frame, p2, true);
-        if (last_startup.game_frame == 0) {
-            log_error("Player start up buffer has invalid state (cannot get last)");
-            reset_string_sm();
-            return false;
-        }
+        *last_startup = *first_startup;
+        return true;
+    }
+
+    *last_startup = get_startup_frame<P>(last_previous_frame, true);
+    if (last_startup->game_frame == 0) {
+        log_error("Player start up buffer has invalid state (cannot get last)");
+        return false;
+    }
+
+    return true;
+}
+
+template<Player P>
+bool FrameDataAnalyser::calculate_multihit_string() {
+    const RingBuffer<GameFrame> *const player_connections = &side_state<P>()->str_connection_frames;
+    const GameFrame *const first_connection = player_connections->tail();
+    const GameFrame *const last_connection = player_connections->head();
+
+    StartFrame first_startup{};
+    StartFrame last_startup{};
+    if (!get_string_startups<P>(&first_startup, &last_startup)) {
+        reset_string_sm();
+        return false;
     }
 
     log_debug("calculate multi-hit string");
     // Calculate frame data for natural string
     int32_t startup_frames = (int) (first_connection->game_frame - first_startup.game_frame); // NOLINT
-    uint32_t frame_delta = last_connection->game_frame - first_startup.game_frame;
-    int32_t frame_advantage = 0;
-    bool knock_down = false;
+    const uint32_t frame_delta = last_connection->game_frame - first_startup.game_frame;
+    const PlayerFrame *const player = player_frame<P>(last_connection);
+    const PlayerFrame *const opponent = opponent_frame<P>(last_connection);
+
+    const bool knock_down = is_knockdown(opponent);
+    const auto frame_advantage = (int) (opponent->recovery_frames - player->recovery_frames + frame_delta);
 
-    if (p2) {
-        knock_down = is_knockdown(&last_connection->p1);
-        frame_advantage =
-            (int) (last_connection->p1.recovery_frames - last_connection->p2.recovery_frames + frame_delta);
+    // Startup frames are only shown for P1
+    if constexpr (P == Player::P2) {
         startup_frames = 0;
-    } else {
-        knock_down = is_knockdown(&last_connection->p2);
-        frame_advantage =
-            (int) (last_connection->p2.recovery_frames - last_connection->p1.recovery_frames + frame_delta);
     }
 
     const struct FrameDataPoint data_point = {.startup_frames = startup_frames,
                                               .frame_advantage = frame_advantage,
                                               .knock_down = knock_down};
 
-    m_listener->frame_data(data_point);
+    publish_frame_data(data_point);
 
     reset_string_sm();
 
     return true;
 }
 
-bool FrameDataAnalyser::calculate_natural_string(RingBuffer<GameFrame> *const player_connections, const bool p2) {
+template<Player P>
+bool FrameDataAnalyser::calculate_natural_string() {
+    const RingBuffer<GameFrame> *const player_connections = &side_state<P>()->str_connection_frames;
     const GameFrame *const first_connection = player_connections->tail();
-    const GameFrame *const first_previous_frame = get_game_frame(first_connection->game_frame - 1);
     const GameFrame *const last_connection = player_connections->head();
-    const GameFrame *const last_previous_frame = get_game_frame(last_connection->game_frame - 1);
 
-    if (first_previous_frame == nullptr) {
-        log_error("cannot find previous frame for startup");
-        reset_string_sm();
-        return false;
-    }
-
-    if (last_previous_frame == nullptr) {
-        log_error("cannot find previous frame for connection");
-        reset_string_sm();
-        return false;
-    }
-
-    const StartFrame first_startup = get_startup_frame(first_previous_frame, p2, true);
-    if (first_startup.game_frame == 0) {
-        log_error("Player start up buffer has invalid state (cannot get first)");
+    StartFrame first_startup{};
+    StartFrame last_startup{};
+    if (!get_string_startups<P>(&first_startup, &last_startup)) {
         reset_string_sm();
         return false;
     }
 
-    // Check if first and last are the same
-    StartFrame last_startup{};
-
-    if (first_connection->game_frame == last_connection->game_frame) {
-        last_startup = first_startup;
-    } else {
-        last_startup = get_startup_frame(last_previous_frame, p2, true);
-        if (last_startup.game_frame == 0) {
-            log_error("Player start up buffer has invalid state (cannot get last)");
-            reset_string_sm();
-            return false;
-        }
-    }
+    // Found by get_string_startups
+    const GameFrame *const last_previous_frame = get_game_frame(last_connection->game_frame - 1);
 
     log_debug("calculate natural string");
     // Calculate frame data for natural string
     int32_t startup_frames = (int) (first_connection->game_frame - first_startup.game_frame); // NOLINT
     const int last_startup_frames = (int) (last_connection->game_frame - last_startup.game_frame);
+    const PlayerFrame *const player = player_frame<P>(last_connection);
+    const PlayerFrame *const opponent = opponent_frame<P>(last_connection);
     int32_t frame_advantage = 0;
-    bool knock_down = false;
 
-    if (p2) {
-        knock_down = is_knockdown(&last_connection->p1);
-        // Don't base recovery time on startup frame if new recovery has begun
-        if (recovery_reset(&last_previous_frame->p2, &last_connection->p2)) {
-            frame_advantage = (int) (last_connection->p1.recovery_frames - last_connection->p2.recovery_frames);
-        } else {
-            frame_advantage =
-                (int) ((last_startup.recovery_frames - last_connection->p1.recovery_frames) - last_startup_frames);
-        }
-        startup_frames = 0;
+    const bool knock_down = is_knockdown(opponent);
+    // Don't base recovery time on startup frame if new recovery has begun
+    if (recovery_reset(player_frame<P>(last_previous_frame), player)) {
+        frame_advantage = (int) (opponent->recovery_frames - player->recovery_frames);
     } else {
-        knock_down = is_knockdown(&last_connection->p2);
-        // Don't base recovery time on startup frame if new recovery has begun
-        if (recovery_reset(&last_previous_frame->p1, &last_connection->p1)) {
-            frame_advantage = (int) (last_connection->p2.recovery_frames - last_connection->p1.recovery_frames);
-        } else {
-            frame_advantage =
-                (int) (last_startup_frames - (last_startup.recovery_frames - last_connection->p2.recovery_frames));
+        frame_advantage = (int) (last_startup_frames - (last_startup.recovery_frames - opponent->recovery_frames));
+        // Frame advantage is from P1's point of view
+        if constexpr (P == Player::P2) {
+            frame_advantage = -frame_advantage;
         }
     }
 
+    // Startup frames are only shown for P1
+    if constexpr (P == Player::P2) {
+        startup_frames = 0;
+    }
+
     const struct FrameDataPoint data_point = {.startup_frames = startup_frames,
                                               .frame_advantage = frame_advantage,
                                               .knock_down = knock_down};
 
-    m_listener->frame_data(data_point);
+    publish_frame_data(data_point);
 
     reset_string_sm();
 
     return true;
 }
 
-bool FrameDataAnalyser::calculate_strings(const bool p2) {
+template<Player P>
+bool FrameDataAnalyser::calculate_strings() {
     const GameFrame *const current = m_frame_buffer.head();
-    const PlayerFrame *player{};
-    RingBuffer<GameFrame> *player_connections{};
-
-    if (p2) {
-        player_connections = &m_p2_str_connection_frames;
-        player = &current->p2;
-    } else {
-        player_connections = &m_p1_str_connection_frames;
-        player = &current->p1;
-    }
+    PlayerAnalysisState *const state = side_state<P>();
+    const PlayerFrame *const player = player_frame<P>(current);
 
     // Push string type frames
     if (is_multihit_attack(player)) {
-        push_string_type(current, p2);
+        state->str_type_frames.push(*current);
     }
 
     // No string ended state, or no data: nothing to handle
-    if (!string_has_ended_state(player) || player_connections->item_count() == 0) {
+    if (!string_has_ended_state(player) || state->str_connection_frames.item_count() == 0) {
         return false;
     }
 
     // Check if the string has concluded (state may be ended for few frames, but string continues)
-    if (!string_has_concluded(current, p2)) {
+    if (!string_has_concluded<P>(current)) {
         return false;
     }
 
-    if (string_is_multihit_attack(player_connections, p2)) {
-        return calculate_multihit_string(player_connections, p2);
+    if (string_is_multihit_attack<P>()) {
+        return calculate_multihit_string<P>();
     }
 
-    return calculate_natural_string(player_connections, p2);
+    return calculate_natural_string<P>();
 }
 
-void FrameDataAnalyser::calculate_single_attack(const ConnectionEvent connection,
-                                                const GameFrame *const previous,
-                                                const GameFrame *const current) {
-    StartFrame startup{};
-    // Value in current frame
-    const PlayerFrame *player{};
-    const PlayerFrame *opponent{};
-
+template<Player P>
+void FrameDataAnalyser::calculate_single_attack(const GameFrame *const previous, const GameFrame *const current) {
     // Check frame before connection, as the player can initiate new attack on connection frame
-    if (connection == ConnectionEvent::P1_CONNECTION) {
-        m_p2_start_frames.clear();
-        startup = get_startup_frame(previous, false, true);
-
-        player = &current->p1;
-        opponent = &current->p2;
-    } else {
-        m_p1_start_frames.clear();
-        startup = get_startup_frame(previous, true, true);
+    side_state<opponent(P)>()->start_frames.clear();
+    const StartFrame startup = get_startup_frame<P>(previous, true);
 
-        player = &current->p2;
-        opponent = &current->p1;
-    }
+    // Value in current frame
+    const PlayerFrame *const player = player_frame<P>(current);
+    const PlayerFrame *const opponent = opponent_frame<P>(current);
 
     if (startup.game_frame == 0) {
         log_error("Player start up buffer has invalid state");
@@ -613,22 +618,20 @@ void FrameDataAnalyser::calculate_single_attack(const ConnectionEvent connection
     int32_t frame_advantage = 0;
     const bool knock_down = is_knockdown(opponent);
 
-    if (connection == ConnectionEvent::P1_CONNECTION) {
-        // Don't base recovery time on startup frame if new recovery has begun
-        // Or the connection is grab
-        if (recovery_reset(&previous->p1, player) || player_in_stasis(player)) {
-            frame_advantage = (int) (opponent->recovery_frames - player->recovery_frames);
-        } else {
-            frame_advantage = (int) (startup_frames - (startup.recovery_frames - opponent->recovery_frames));
-        }
+    // Don't base recovery time on startup frame if new recovery has begun
+    // Or the connection is grab
+    if (recovery_reset(player_frame<P>(previous), player) || player_in_stasis(player)) {
+        frame_advantage = (int) (opponent->recovery_frames - player->recovery_frames);
     } else {
-        // Don't base recovery time on startup frame if new recovery has begun
-        // Or the connection is grab
-        if (recovery_reset(&previous->p2, player) || player_in_stasis(player)) {
-            frame_advantage = (int) (opponent->recovery_frames - player->recovery_frames);
-        } else {
-            frame_advantage = (int) ((startup.recovery_frames - opponent->recovery_frames) - startup_frames);
+        frame_advantage = (int) (startup_frames - (startup.recovery_frames - opponent->recovery_frames));
+        // Frame advantage is from P1's point of view
+        if constexpr (P == Player::P2) {
+            frame_advantage = -frame_advantage;
         }
+    }
+
+    // Startup frames are only shown for P1
+    if constexpr (P == Player::P2) {
         startup_frames = 0;
     }
 
@@ -636,50 +639,55 @@ void FrameDataAnalyser::calculate_single_attack(const ConnectionEvent connection
                                               .frame_advantage = frame_advantage,
                                               .knock_down = knock_down};
 
-    m_listener->frame_data(data_point);
+    publish_frame_data(data_point);
 }
 
-void FrameDataAnalyser::handle_connection() {
-    const ConnectionEvent connection = has_new_connection();
-    if (connection == ConnectionEvent::NO_CONNECTION) {
-        return;
-    }
+template<Player P>
+void FrameDataAnalyser::handle_player_connection() {
     const GameFrame *const current = m_frame_buffer.head();
     const GameFrame *const previous = m_frame_buffer.get_from_head(1);
 
     if (m_logging) {
-        log_info("MARK CONNECTION P%i: %i", connection, current->game_frame);
+        log_info("MARK CONNECTION P%i: %i", (int) P + 1, current->game_frame);
     }
 
-    const StartFrame startup = get_startup_frame(current, connection == ConnectionEvent::P2_CONNECTION, false);
+    const StartFrame startup = get_startup_frame<P>(current, false);
 
     // Handle string later on separate function
-    if (connection == ConnectionEvent::P1_CONNECTION) {
-        if (startup.is_string && string_is_active(&current->p1)) {
-            m_p1_str_connection_frames.push(*current);
-            return;
-        }
-    } else {
-        if (startup.is_string && string_is_active(&current->p2)) {
-            m_p2_str_connection_frames.push(*current);
-            return;
-        }
+    if (startup.is_string && string_is_active(player_frame<P>(current))) {
+        side_state<P>()->str_connection_frames.push(*current);
+        return;
     }
 
-    calculate_single_attack(connection, previous, current);
+    calculate_single_attack<P>(previous, current);
+}
+
+void FrameDataAnalyser::handle_connection() {
+    TRACE_SCOPE("connection");
+    switch (has_new_connection()) {
+    case ConnectionEvent::P1_CONNECTION:
+        handle_player_connection<Player::P1>();
+        break;
+    case ConnectionEvent::P2_CONNECTION:
+        handle_player_connection<Player::P2>();
+        break;
+    case ConnectionEvent::NO_CONNECTION:
+        break;
+    }
 }
 
 void FrameDataAnalyser::handle_strings() {
+    TRACE_SCOPE("strings");
     const GameFrame *const current = m_frame_buffer.head();
 
     // Try to caluculate P1
-    if (should_handle_string(&current->p1, false) && calculate_strings(false)) {
+    if (should_handle_string<Player::P1>(&current->p1) && calculate_strings<Player::P1>()) {
         return;
     }
 
     // Try to calculate P2
-    if (should_handle_string(&current->p2, true)) {
-        calculate_strings(true);
+    if (should_handle_string<Player::P2>(&current->p2)) {
+        calculate_strings<Player::P2>();
     }
 }
 
@@ -690,14 +698,65 @@ float FrameDataAnalyser::calculate_distance(const GameFrame *const state) {
 }
 
 void FrameDataAnalyser::handle_distance() {
+    TRACE_SCOPE("distance");
     const GameFrame *const current = m_frame_buffer.head();
     const float distance = calculate_distance(current);
-    m_listener->distance(distance);
+
+    if (std::fabs(distance - m_last_distance) < DISTANCE_EPSILON) {
+        return;
+    }
+
+    m_last_distance = distance;
+    m_tick_events.distance = distance;
+    m_tick_events.changed |= TICK_DISTANCE;
 }
 
 void FrameDataAnalyser::handle_status() {
+    TRACE_SCOPE("status");
     const GameFrame *const current = m_frame_buffer.head();
-    m_listener->status((PlayerState) current->p1.state);
+
+    if (current->p1.state == m_last_status) {
+        return;
+    }
+
+    m_last_status = current->p1.state;
+    m_tick_events.status = (PlayerState) current->p1.state;
+    m_tick_events.changed |= TICK_STATUS;
+}
+
+void FrameDataAnalyser::publish_frame_data(const FrameDataPoint &data_point) {
+    // Publish an earlier result of the same tick instead of overwriting it
+    if ((m_tick_events.changed & TICK_FRAME_DATA) != 0) {
+        emit_tick_events();
+    }
+
+    m_tick_events.frame_data = data_point;
+    m_tick_events.changed |= TICK_FRAME_DATA;
+}
+
+void FrameDataAnalyser::emit_tick_events() {
+    // Every sink sees each publish of the tick, the exporter also unchanged ticks
+    if (FrameExporter::enabled()) {
+        FrameExporter::publish(*m_frame_buffer.head(), m_tick_events);
+    }
+    if (m_tick_events.changed == 0) {
+        return;
+    }
+
+    if (ShadowAnalyser::enabled()) {
+        ShadowAnalyser::add_events(m_tick_events);
+    }
+    if (EventServer::enabled()) {
+        EventServer::publish(m_tick_events);
+    }
+
+    TickProfiler::mark(TickStage::PUBLISH);
+    {
+        TRACE_SCOPE("listener");
+        m_listener->tick(m_tick_events);
+    }
+    TickProfiler::mark(TickStage::LISTENER);
+    m_tick_events.changed = 0;
 }
 
 bool FrameDataAnalyser::flip_player_data(GameFrame &state) {
@@ -730,23 +789,30 @@ bool FrameDataAnalyser::flip_player_data(GameFrame &state) {
 }
 
 bool FrameDataAnalyser::update_game_state() {
+    TRACE_SCOPE("read game state");
+
     // Read the game's state
     GameFrame state{};
     if (read_game_state(&state) != READ_OK) {
         return false;
     }
+    TickProfiler::mark(TickStage::READ);
 
     // Flip player data according to player side
     if (!flip_player_data(state)) {
         return false;
     }
 
-    m_frame_buffer.push(state);
+    push_frame(state);
+    TickProfiler::mark(TickStage::FLIP);
 
     return true;
 }
 
 bool FrameDataAnalyser::loop() {
+    TRACE_SCOPE("tick");
+    TickProfiler::begin_tick();
+
     // Analyser timing
     uint32_t current_frame = 0;
     const int result = current_game_frame(&current_frame);
@@ -766,7 +832,10 @@ bool FrameDataAnalyser::loop() {
         }
 
         log_warn("analyser is off by \"%lld\" frames", frames_off);
+        m_tick_events.frames_off = (int32_t) frames_off;
+        m_tick_events.changed |= TICK_RESYNC;
     }
+    TickProfiler::mark(TickStage::SYNC);
 
     // Analysis logic
     if (!update_game_state()) {
@@ -774,24 +843,73 @@ bool FrameDataAnalyser::loop() {
         return false;
     }
 
+    analyse_frame();
+    TickProfiler::end_tick();
+    return true;
+}
+
+void FrameDataAnalyser::process_frame(const GameFrame &frame) {
+    m_frame_buffer.push(frame);
+    analyse_frame();
+}
+
+void FrameDataAnalyser::push_frame(const GameFrame &frame) {
+    m_frame_buffer.push(frame);
+}
+
+void FrameDataAnalyser::analyse_frame() {
+    const bool shadow = ShadowAnalyser::enabled();
+    const auto start = shadow ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
+
+    m_tick_events.tick++;
     analyse_start_frames();
+    TickProfiler::mark(TickStage::START_FRAMES);
     handle_connection();
+    TickProfiler::mark(TickStage::CONNECTION);
     handle_strings();
+    TickProfiler::mark(TickStage::STRINGS);
     handle_distance();
+    TickProfiler::mark(TickStage::DISTANCE);
     handle_status();
+    TickProfiler::mark(TickStage::STATUS);
+
+    const auto delta = shadow ? std::chrono::steady_clock::now() - start : std::chrono::steady_clock::duration{};
+    emit_tick_events();
+
+    if (shadow) {
+        const auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(delta).count();
+        ShadowAnalyser::record(*m_frame_buffer.head(), nanos);
+    }
 
     if (m_logging) {
         log_frame();
     }
 
-    return true;
+    if (FrameTrace::enabled()) {
+        FrameTrace::record(*m_frame_buffer.head());
+    }
+    TickProfiler::mark(TickStage::PUBLISH);
+}
+
+void FrameDataAnalyser::reset(EventListener *listener) {
+    m_listener = listener;
+
+    // Report everything on the first tick
+    m_tick_events = {};
+    m_last_distance = -1;
+    m_last_status = -1;
+
+    m_frame_buffer.clear();
+    m_p1_state.start_frames.clear();
+    m_p2_state.start_frames.clear();
+    reset_string_sm();
 }
 
 bool FrameDataAnalyser::init(EventListener *listener) {
     if (listener == nullptr) {
         return false;
     }
-    FrameDataAnalyser::m_listener = listener;
+    reset(listener);
 
     const int result = init_memory_reader();
     if (result != MR_INIT_OK) {
@@ -804,16 +922,23 @@ bool FrameDataAnalyser::init(EventListener *listener) {
         return false;
     }
 
+    if (ShadowAnalyser::enabled()) {
+        ShadowAnalyser::seed(*m_frame_buffer.head());
+    }
+
     return true;
 }
 
 bool FrameDataAnalyser::start(EventListener *listener) {
+    SpanTracer::set_thread_name("analyser");
+    PerfCounters::attach_thread();
     if (!init(listener)) {
         log_error("failed to init analyser");
         return false;
     }
 
-    m_listener->game_hooked();
+    m_tick_events.hooked = true;
+    m_tick_events.changed |= TICK_HOOK;
 
     // Main loop
     while (!m_stop) {
@@ -821,6 +946,11 @@ bool FrameDataAnalyser::start(EventListener *listener) {
 
         if (!loop()) {
             // Unrecoverable error has occurred
+            m_tick_events.hooked = false;
+            m_tick_events.changed |= TICK_HOOK;
+            emit_tick_events();
+
+            dump_unknown_ids();
             return false;
         }
         auto end = std::chrono::high_resolution_clock::now();
@@ -838,6 +968,8 @@ bool FrameDataAnalyser::start(EventListener *listener) {
         }
     }
 
+    dump_unknown_ids();
+
     return true;
 }
 
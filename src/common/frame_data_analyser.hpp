@@ -18,6 +18,7 @@
 #ifndef FRAME_DATA_ANALYSER_HPP
 #define FRAME_DATA_ANALYSER_HPP
 
+#include "lookup_tables.hpp"
 #include "ring_buffer.hpp"
 
 #include "game_state_reader.h"
@@ -36,12 +37,40 @@ struct StartFrame {
     bool is_string;
 };
 
+enum class Player : uint8_t {
+    P1,
+    P2
+};
+
+constexpr Player opponent(const Player player) {
+    return player == Player::P1 ? Player::P2 : Player::P1;
+}
+
+// Analysis state of a single player
+struct PlayerAnalysisState {
+    PlayerAnalysisState();
+
+    RingBuffer<StartFrame> start_frames;
+    // String connection frames
+    RingBuffer<GameFrame> str_connection_frames;
+    // String end frames
+    RingBuffer<GameFrame> str_end_frames;
+    // String type frames
+    RingBuffer<GameFrame> str_type_frames;
+};
+
 enum ConnectionEvent : uint8_t {
     NO_CONNECTION,
     P1_CONNECTION,
     P2_CONNECTION
 };
 
+// Run the tool twice as fast as the game to get accurate measurements
+#define TICK_LENGTH 8333333
+
+// Unknown state and intent ids tracked for debugging
+#define UNKNOWN_ID_TABLE_SIZE 32
+
 enum class PlayerState : int {
     STANDING = 6482,
     CROUCH = 538921,
@@ -120,6 +149,28 @@ enum class StringType : uint16_t {
     MULTIHIT2 = 1027,
 };
 
+// TickEvents fields which have changed
+enum TickEventFlag : uint8_t {
+    TICK_FRAME_DATA = 1 << 0,
+    TICK_DISTANCE = 1 << 1,
+    TICK_STATUS = 1 << 2,
+    TICK_HOOK = 1 << 3,
+    TICK_RESYNC = 1 << 4
+};
+
+// Changes during a single analyser tick, only fields flagged in "changed" are valid
+struct TickEvents {
+    uint8_t changed;
+    // Analysed frames since the analyser was reset, always valid
+    uint32_t tick;
+    FrameDataPoint frame_data;
+    float distance;
+    PlayerState status;
+    bool hooked;
+    // Frames the analyser was off from the game
+    int32_t frames_off;
+};
+
 class EventListener {
 public:
     virtual ~EventListener() = default;
@@ -129,13 +180,18 @@ public:
     EventListener &operator=(const EventListener &) = default;
     EventListener &operator=(EventListener &&) = default;
 
-    virtual void frame_data(FrameDataPoint frame_data) = 0;
-    virtual void distance(float distance) = 0;
-    virtual void status(PlayerState status) = 0;
-    virtual void game_hooked() = 0;
+    /**
+     * Called at the end of a tick if anything has changed
+     *
+     * @param events changed values
+     */
+    virtual void tick(const TickEvents &events) = 0;
 };
 
 class FrameDataAnalyser {
+    // Tests fill the tick events directly, frame input does not produce two results in one tick
+    friend class FrameDataAnalyserTest;
+
 public:
     FrameDataAnalyser() = delete;
     ~FrameDataAnalyser() = delete;
@@ -158,64 +214,110 @@ public:
     static bool should_stop();
 
     static const char *player_status(const PlayerState state);
+    /**
+     * Log unknown player states and intents seen so far
+     */
+    static void dump_unknown_ids();
     static void set_logging(const bool enabled);
 
+    /**
+     * Clear analysis state and frame history, done by start before hooking
+     *
+     * @param listener listener of tick events
+     */
+    static void reset(EventListener *listener);
+    /**
+     * Analyse a single side flipped game frame as one analyser tick,
+     * lets tests and benchmarks drive the analyser without the game
+     *
+     * @param frame game frame
+     */
+    static void process_frame(const GameFrame &frame);
+    /**
+     * Add side flipped game frame to the frame history without analysing it
+     *
+     * @param frame game frame
+     */
+    static void push_frame(const GameFrame &frame);
+    /**
+     * Find frame from the frame history
+     *
+     * @param game_frame game frame number
+     * @return frame or nullptr if not in the history
+     */
+    static const GameFrame *get_game_frame(const uint32_t game_frame);
+
 private:
     static volatile bool m_stop;
     static RingBuffer<GameFrame> m_frame_buffer;
     static EventListener *m_listener;
-    static int m_last_player_intent;
+    static TickEvents m_tick_events;
+    static float m_last_distance;
+    static int32_t m_last_status;
+    static UnknownIdCounter<UNKNOWN_ID_TABLE_SIZE> m_unknown_states;
+    static UnknownIdCounter<UNKNOWN_ID_TABLE_SIZE> m_unknown_intents;
     static bool m_logging;
 
     // Analysis state
-    static RingBuffer<StartFrame> m_p1_start_frames;
-    static RingBuffer<StartFrame> m_p2_start_frames;
-    // String connection frames
-    static RingBuffer<GameFrame> m_p1_str_connection_frames;
-    static RingBuffer<GameFrame> m_p2_str_connection_frames;
-    // String end frames
-    static RingBuffer<GameFrame> m_p1_str_end_frames;
-    static RingBuffer<GameFrame> m_p2_str_end_frames;
-    // String type frames
-    static RingBuffer<GameFrame> m_p1_str_type_frames;
-    static RingBuffer<GameFrame> m_p2_str_type_frames;
-
+    static PlayerAnalysisState m_p1_state;
+    static PlayerAnalysisState m_p2_state;
 
     static bool init(EventListener *listener);
     static bool loop();
 
+    template<Player P>
+    inline static PlayerAnalysisState *side_state();
+    template<Player P>
+    inline static const PlayerFrame *player_frame(const GameFrame *const frame);
+    template<Player P>
+    inline static const PlayerFrame *opponent_frame(const GameFrame *const frame);
+
     inline static void log_frame();
     inline static bool flip_player_data(GameFrame &state);
-    inline static bool is_attack(const PlayerIntent &intent);
+    static bool is_attack(const PlayerIntent &intent);
     inline static bool recovery_reset(const PlayerFrame *const previous, const PlayerFrame *const current);
-    static const GameFrame *get_game_frame(const uint32_t game_frame);
-    static StartFrame get_startup_frame(const GameFrame *const frame, const bool p2, const bool pop);
+    template<Player P>
+    static StartFrame get_startup_frame(const GameFrame *const frame, const bool pop);
 
     inline static bool initiated_attack(const PlayerFrame *const previous, const PlayerFrame *const current);
+    template<Player P>
+    inline static void mark_start_frame(const GameFrame *const previous, const GameFrame *const current);
     static void analyse_start_frames();
     static bool update_game_state();
+    static void analyse_frame();
     static ConnectionEvent has_new_connection();
     inline static bool player_in_stasis(const PlayerFrame *const player_frame);
     inline static bool string_is_active(const PlayerFrame *const player_frame);
     inline static bool is_knockdown(const PlayerFrame *const player_frame);
-    inline static bool has_string_startup(const bool p2);
-    inline static bool should_handle_string(const PlayerFrame *const player_frame, const bool p2);
+    template<Player P>
+    inline static bool has_string_startup();
+    template<Player P>
+    inline static bool should_handle_string(const PlayerFrame *const player_frame);
     inline static bool string_has_ended_state(const PlayerFrame *const player_frame);
     inline static void reset_string_sm();
-    inline static void push_string_type(const GameFrame *const frame, const bool p2);
     inline static bool is_multihit_attack(const PlayerFrame *const player);
-    static bool string_is_multihit_attack(RingBuffer<GameFrame> *const player_connections, const bool p2);
-    static bool calculate_multihit_string(RingBuffer<GameFrame> *const player_connections, const bool p2);
-    static bool calculate_natural_string(RingBuffer<GameFrame> *const player_connections, const bool p2);
-    static bool calculate_strings(const bool p2);
-    static bool string_has_concluded(const GameFrame *const current, const bool p2);
-    static void calculate_single_attack(const ConnectionEvent connection,
-                                        const GameFrame *const previous,
-                                        const GameFrame *const current);
+    template<Player P>
+    static bool string_is_multihit_attack();
+    template<Player P>
+    static bool get_string_startups(StartFrame *first_startup, StartFrame *last_startup);
+    template<Player P>
+    static bool calculate_multihit_string();
+    template<Player P>
+    static bool calculate_natural_string();
+    template<Player P>
+    static bool calculate_strings();
+    template<Player P>
+    static bool string_has_concluded(const GameFrame *const current);
+    template<Player P>
+    static void calculate_single_attack(const GameFrame *const previous, const GameFrame *const current);
+    template<Player P>
+    static void handle_player_connection();
     static void handle_connection();
     static void handle_strings();
     static void handle_distance();
     static void handle_status();
+    static void publish_frame_data(const FrameDataPoint &data_point);
+    static void emit_tick_events();
 
     static float calculate_distance(const GameFrame *const state);
 };
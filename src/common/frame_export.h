@@ -0,0 +1,131 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/*
+  Layout of the live frame data shared memory segment
+
+  External readers map the segment read-only and copy a consistent
+  snapshot with frame_export_read(), which never makes a syscall. The
+  header is self-contained, it does not need the memory reader headers:
+
+    int fd = shm_open(FRAME_EXPORT_NAME, O_RDONLY, 0);
+    const struct FrameExport *shm = mmap(NULL, sizeof(struct FrameExport), PROT_READ, MAP_SHARED, fd, 0);
+    struct FrameExportSnapshot snapshot;
+    frame_export_read(shm, &snapshot);
+
+  Requires GCC or Clang atomic builtins.
+*/
+
+#ifndef FRAME_EXPORT_H
+#define FRAME_EXPORT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#define FRAME_EXPORT_NAME "/t6framedata"
+// Longest segment name with the terminator
+#define FRAME_EXPORT_NAME_SIZE 64
+#define FRAME_EXPORT_MAGIC 0x45463654U // "T6FE"
+#define FRAME_EXPORT_VERSION 1
+
+// Same layout as the analyser's side flipped game frame
+struct FrameExportPosition {
+    float x;
+    float y;
+    float z;
+};
+
+struct FrameExportPlayer {
+    int32_t frames_last_action;
+    uint32_t recovery_frames;
+    int8_t connection;
+    int32_t intent;
+    int32_t move;
+    int32_t state;
+    int32_t string_state;
+    int32_t string_type;
+    struct FrameExportPosition position;
+    int32_t attack_seq;
+};
+
+struct FrameExportGameFrame {
+    uint32_t game_frame;
+    struct FrameExportPlayer p1;
+    struct FrameExportPlayer p2;
+};
+
+struct FrameExportPoint {
+    int32_t startup_frames;
+    int32_t frame_advantage;
+    int32_t knock_down;
+};
+
+struct FrameExportSnapshot {
+    // Publishes so far, one per analyser tick and one more for each earlier frame data result of the tick
+    uint64_t tick;
+    // Tick on which frame_data was last updated, 0 if never
+    uint64_t frame_data_tick;
+    struct FrameExportGameFrame game_frame;
+    struct FrameExportPoint frame_data;
+};
+
+struct FrameExport {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t size;
+    uint32_t game_frame_size;
+    // Seqlock sequence, odd while the writer is updating the snapshot
+    uint64_t sequence;
+    struct FrameExportSnapshot snapshot;
+};
+
+/**
+ * Check that the mapped segment is compatible with this header
+ *
+ * @param shm mapped segment
+ * @return 1 if compatible
+ */
+static inline int frame_export_valid(const struct FrameExport *shm) {
+    return shm->magic == FRAME_EXPORT_MAGIC && shm->version == FRAME_EXPORT_VERSION &&
+           shm->size == sizeof(struct FrameExport) && shm->game_frame_size == sizeof(struct FrameExportGameFrame);
+}
+
+/**
+ * Copy a consistent snapshot, retries while the writer is updating it
+ *
+ * @param shm mapped segment
+ * @param snapshot copied snapshot
+ */
+static inline void frame_export_read(const struct FrameExport *shm, struct FrameExportSnapshot *snapshot) {
+    uint64_t begin = 0;
+    uint64_t end = 0;
+    do {
+        begin = __atomic_load_n(&shm->sequence, __ATOMIC_ACQUIRE);
+        *snapshot = shm->snapshot;
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        end = __atomic_load_n(&shm->sequence, __ATOMIC_RELAXED);
+    } while ((begin & 1U) != 0 || begin != end);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
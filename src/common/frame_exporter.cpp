@@ -0,0 +1,116 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "frame_exporter.hpp"
+
+#include <cstddef>
+#include <cstring>
+
+#include "logging.h"
+
+// The exported frame is a copy of the game frame
+#define SAME_FIELD(type, export_type, field)                                                                           \
+    static_assert(offsetof(type, field) == offsetof(export_type, field) &&                                             \
+                  sizeof(type::field) == sizeof(export_type::field))
+
+static_assert(sizeof(GameFrame) == sizeof(FrameExportGameFrame));
+SAME_FIELD(GameFrame, FrameExportGameFrame, game_frame);
+SAME_FIELD(GameFrame, FrameExportGameFrame, p1);
+SAME_FIELD(GameFrame, FrameExportGameFrame, p2);
+static_assert(sizeof(PlayerFrame) == sizeof(FrameExportPlayer));
+SAME_FIELD(PlayerFrame, FrameExportPlayer, frames_last_action);
+SAME_FIELD(PlayerFrame, FrameExportPlayer, recovery_frames);
+SAME_FIELD(PlayerFrame, FrameExportPlayer, connection);
+SAME_FIELD(PlayerFrame, FrameExportPlayer, intent);
+SAME_FIELD(PlayerFrame, FrameExportPlayer, move);
+SAME_FIELD(PlayerFrame, FrameExportPlayer, state);
+SAME_FIELD(PlayerFrame, FrameExportPlayer, string_state);
+SAME_FIELD(PlayerFrame, FrameExportPlayer, string_type);
+SAME_FIELD(PlayerFrame, FrameExportPlayer, position);
+SAME_FIELD(PlayerFrame, FrameExportPlayer, attack_seq);
+static_assert(sizeof(PlayerCoordinate) == sizeof(FrameExportPosition));
+SAME_FIELD(PlayerCoordinate, FrameExportPosition, x);
+SAME_FIELD(PlayerCoordinate, FrameExportPosition, y);
+SAME_FIELD(PlayerCoordinate, FrameExportPosition, z);
+
+FrameExport *FrameExporter::m_shm = nullptr;
+uint64_t FrameExporter::m_tick = 0;
+char FrameExporter::m_name[FRAME_EXPORT_NAME_SIZE] = {};
+
+bool FrameExporter::start(const char *name) {
+    if (m_shm != nullptr) {
+        return true;
+    }
+
+    if (name[0] != '/' || strlen(name) >= sizeof(m_name)) {
+        log_error("invalid shared memory name \"%s\"", name);
+        return false;
+    }
+    strcpy(m_name, name); // NOLINT
+
+    FrameExport *shm = map_segment(m_name);
+    if (shm == nullptr) {
+        return false;
+    }
+
+    memset(shm, 0, sizeof(*shm)); // NOLINT
+    shm->size = sizeof(FrameExport);
+    shm->game_frame_size = sizeof(FrameExportGameFrame);
+    shm->version = FRAME_EXPORT_VERSION;
+    // Readers check the magic last
+    __atomic_store_n(&shm->magic, FRAME_EXPORT_MAGIC, __ATOMIC_RELEASE);
+
+    m_tick = 0;
+    m_shm = shm;
+
+    log_info("publishing frame data to shared memory \"%s\"", m_name);
+    return true;
+}
+
+void FrameExporter::stop() {
+    if (m_shm == nullptr) {
+        return;
+    }
+
+    unmap_segment(m_shm, m_name);
+    m_shm = nullptr;
+}
+
+bool FrameExporter::enabled() {
+    return m_shm != nullptr;
+}
+
+void FrameExporter::publish(const GameFrame &frame, const TickEvents &events) {
+    m_tick++;
+
+    // Seqlock write: odd sequence while the snapshot is inconsistent
+    const uint64_t sequence = __atomic_load_n(&m_shm->sequence, __ATOMIC_RELAXED);
+    __atomic_store_n(&m_shm->sequence, sequence + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    FrameExportSnapshot &snapshot = m_shm->snapshot;
+    snapshot.tick = m_tick;
+    memcpy(&snapshot.game_frame, &frame, sizeof(snapshot.game_frame)); // NOLINT
+    if ((events.changed & TICK_FRAME_DATA) != 0) {
+        snapshot.frame_data_tick = m_tick;
+        snapshot.frame_data = {.startup_frames = events.frame_data.startup_frames,
+                               .frame_advantage = events.frame_data.frame_advantage,
+                               .knock_down = events.frame_data.knock_down ? 1 : 0};
+    }
+
+    __atomic_store_n(&m_shm->sequence, sequence + 2, __ATOMIC_RELEASE);
+}
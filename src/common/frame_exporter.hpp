@@ -0,0 +1,72 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef FRAME_EXPORTER_HPP
+#define FRAME_EXPORTER_HPP
+
+#include <cstdint>
+
+#include "frame_data_analyser.hpp"
+#include "frame_export.h"
+
+/**
+ * Publishes live frame data to a shared memory segment
+ *
+ * Readers use the seqlock in frame_export.h, so publishing never waits for them.
+ */
+class FrameExporter {
+public:
+    FrameExporter() = delete;
+    ~FrameExporter() = delete;
+
+    FrameExporter(const FrameExporter &) = delete;
+    FrameExporter(FrameExporter &&) = delete;
+    FrameExporter &operator=(const FrameExporter &) = delete;
+    FrameExporter &operator=(FrameExporter &&) = delete;
+
+    /**
+     * Create and map the segment, fails if another writer owns it
+     *
+     * @param name segment name, FRAME_EXPORT_NAME for readers of the tool
+     * @return true on success
+     */
+    static bool start(const char *name);
+    /**
+     * Unmap and remove the segment
+     */
+    static void stop();
+    static bool enabled();
+
+    /**
+     * Publish the analysed tick (analyser thread only)
+     *
+     * @param frame latest game frame
+     * @param events changes of the tick
+     */
+    static void publish(const GameFrame &frame, const TickEvents &events);
+
+private:
+    static FrameExport *m_shm;
+    static uint64_t m_tick;
+    static char m_name[FRAME_EXPORT_NAME_SIZE];
+
+    // Platform specific
+    static FrameExport *map_segment(const char *name);
+    static void unmap_segment(FrameExport *shm, const char *name);
+};
+
+#endif
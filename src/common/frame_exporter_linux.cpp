@@ -0,0 +1,75 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "frame_exporter.hpp"
+
+#include <cerrno>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "logging.h"
+
+namespace {
+// Kept open while publishing, its lock marks the segment as owned
+int g_fd = -1;
+} // namespace
+
+FrameExport *FrameExporter::map_segment(const char *name) {
+    const int fd = shm_open(name, O_CREAT | O_RDWR | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        log_error("failed to open shared memory \"%s\"", name);
+        return nullptr;
+    }
+
+    // Released by the kernel if the owner dies, a stale segment is taken over
+    if (flock(fd, LOCK_EX | LOCK_NB) != 0) {
+        if (errno == EWOULDBLOCK) {
+            log_error("shared memory \"%s\" is already published by another process", name);
+        } else {
+            log_error("failed to lock shared memory \"%s\"", name);
+        }
+        close(fd);
+        return nullptr;
+    }
+
+    if (ftruncate(fd, sizeof(FrameExport)) != 0) {
+        log_error("failed to resize shared memory");
+        close(fd);
+        return nullptr;
+    }
+
+    void *shm = mmap(nullptr, sizeof(FrameExport), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (shm == MAP_FAILED) {
+        log_error("failed to map shared memory");
+        close(fd);
+        return nullptr;
+    }
+
+    g_fd = fd;
+    return (FrameExport *) shm;
+}
+
+void FrameExporter::unmap_segment(FrameExport *shm, const char *name) {
+    munmap(shm, sizeof(FrameExport));
+    // Unlinked while still owned, so another writer's segment is never removed
+    shm_unlink(name);
+    close(g_fd);
+    g_fd = -1;
+}
@@ -0,0 +1,56 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "frame_exporter.hpp"
+
+#include <windows.h>
+
+#include "logging.h"
+
+namespace {
+HANDLE g_mapping;
+}
+
+FrameExport *FrameExporter::map_segment(const char *name) {
+    // Same name without the POSIX leading slash
+    const char *mapping_name = &name[1];
+    g_mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0, sizeof(FrameExport), mapping_name);
+    if (g_mapping == nullptr) {
+        log_error("failed to create file mapping \"%s\"", mapping_name);
+        return nullptr;
+    }
+    // Open readers keep a mapping alive, it cannot tell a live writer from a stale one
+    if (GetLastError() == ERROR_ALREADY_EXISTS) {
+        log_warn("file mapping \"%s\" already exists, another writer may be publishing to it", mapping_name);
+    }
+
+    void *shm = MapViewOfFile(g_mapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(FrameExport));
+    if (shm == nullptr) {
+        log_error("failed to map file mapping");
+        CloseHandle(g_mapping);
+        g_mapping = nullptr;
+        return nullptr;
+    }
+
+    return (FrameExport *) shm;
+}
+
+void FrameExporter::unmap_segment(FrameExport *shm, const char * /*name*/) {
+    UnmapViewOfFile(shm);
+    CloseHandle(g_mapping);
+    g_mapping = nullptr;
+}
@@ -0,0 +1,244 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "frame_trace.hpp"
+
+#include <chrono>
+#include <cstring>
+
+#include "logging.h"
+
+// Constants
+#define TRACE_MAGIC "T6FT"
+#define TRACE_VERSION 2
+// Roughly 30 seconds of analyser ticks
+#define TRACE_QUEUE_SIZE 4096
+#define TRACE_FLUSH_INTERVAL_MS 100
+
+namespace {
+void copy_player(PlayerFrame &out, const PlayerFrame &in) {
+    out.frames_last_action = in.frames_last_action;
+    out.recovery_frames = in.recovery_frames;
+    out.connection = in.connection;
+    out.intent = in.intent;
+    out.move = in.move;
+    out.state = in.state;
+    out.string_state = in.string_state;
+    out.string_type = in.string_type;
+    out.position = in.position;
+    out.attack_seq = in.attack_seq;
+}
+} // namespace
+
+std::atomic<bool> FrameTrace::m_running = false;
+std::atomic<uint32_t> FrameTrace::m_dropped = 0;
+SpscQueue<GameFrame> FrameTrace::m_queue(TRACE_QUEUE_SIZE);
+FILE *FrameTrace::m_file = nullptr;
+std::thread FrameTrace::m_writer;
+
+bool FrameTrace::start(const char *path) {
+    if (m_running) {
+        return true;
+    }
+
+    m_file = fopen(path, "wb");
+    if (m_file == nullptr) {
+        log_error("failed to open trace file \"%s\"", path);
+        return false;
+    }
+
+    if (!write_header(m_file)) {
+        (void) fclose(m_file);
+        m_file = nullptr;
+        return false;
+    }
+
+    m_dropped = 0;
+    m_running = true;
+    m_writer = std::thread(&writer_loop);
+
+    log_info("tracing frames to \"%s\"", path);
+    return true;
+}
+
+void FrameTrace::stop() {
+    if (!m_running) {
+        return;
+    }
+
+    m_running = false;
+    m_writer.join();
+
+    write_queued();
+    (void) fclose(m_file);
+    m_file = nullptr;
+
+    if (m_dropped > 0) {
+        log_warn("frame trace dropped %u frames", m_dropped.load());
+    }
+}
+
+bool FrameTrace::enabled() {
+    return m_running.load(std::memory_order_relaxed);
+}
+
+void FrameTrace::record(const GameFrame &frame) {
+    if (!m_queue.push(frame)) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void FrameTrace::write_queued() {
+    GameFrame frame{};
+    while (m_queue.pop(frame)) {
+        if (!write_frame(m_file, frame)) {
+            log_error("failed to write trace frame");
+            return;
+        }
+    }
+    (void) fflush(m_file);
+}
+
+void FrameTrace::writer_loop() {
+    while (m_running) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(TRACE_FLUSH_INTERVAL_MS));
+        write_queued();
+    }
+}
+
+int FrameTrace::format(const GameFrame &frame, char *buffer, const size_t size) {
+    return snprintf(buffer, // NOLINT
+                    size,
+                    "FRAME: %u\n"
+                    "P1 last action: %d\n"
+                    "P1 recovery frames: %u\n"
+                    "P1 connection: %d\n"
+                    "P1 intent: %d\n"
+                    "P1 move: %d\n"
+                    "P1 state: %d\n"
+                    "P1 string type: %d\n"
+                    "P1 string state: %d\n"
+                    "P1 position: %g, %g, %g\n"
+                    "P1 attack seq: %d\n"
+                    "P2 last action: %d\n"
+                    "P2 recovery frames: %u\n"
+                    "P2 connection: %d\n"
+                    "P2 intent: %d\n"
+                    "P2 move: %d\n"
+                    "P2 state: %d\n"
+                    "P2 string type: %d\n"
+                    "P2 string state: %d\n"
+                    "P2 position: %g, %g, %g\n"
+                    "P2 attack seq: %d",
+                    frame.game_frame,
+                    frame.p1.frames_last_action,
+                    frame.p1.recovery_frames,
+                    frame.p1.connection != 0,
+                    frame.p1.intent,
+                    frame.p1.move,
+                    frame.p1.state,
+                    frame.p1.string_type,
+                    frame.p1.string_state,
+                    frame.p1.position.x,
+                    frame.p1.position.y,
+                    frame.p1.position.z,
+                    frame.p1.attack_seq,
+                    frame.p2.frames_last_action,
+                    frame.p2.recovery_frames,
+                    frame.p2.connection != 0,
+                    frame.p2.intent,
+                    frame.p2.move,
+                    frame.p2.state,
+                    frame.p2.string_type,
+                    frame.p2.string_state,
+                    frame.p2.position.x,
+                    frame.p2.position.y,
+                    frame.p2.position.z,
+                    frame.p2.attack_seq);
+}
+
+bool FrameTrace::read_header(FILE *file) {
+    FrameTraceHeader header{};
+    if (fread(&header, sizeof(header), 1, file) != 1) {
+        log_error("failed to read trace header");
+        return false;
+    }
+
+    if (memcmp(header.magic, TRACE_MAGIC, sizeof(header.magic)) != 0) { // NOLINT
+        log_error("not a frame trace file");
+        return false;
+    }
+
+    if (header.version != TRACE_VERSION || header.frame_size != sizeof(GameFrame) ||
+        header.layout_version != GAME_FRAME_LAYOUT_VERSION) {
+        log_error("incompatible frame trace (version %u, frame size %u, layout %u)",
+                  header.version,
+                  header.frame_size,
+                  header.layout_version);
+        return false;
+    }
+
+    return true;
+}
+
+bool FrameTrace::write_header(FILE *file) {
+    FrameTraceHeader header = {.magic = {},
+                               .version = TRACE_VERSION,
+                               .frame_size = sizeof(GameFrame),
+                               .layout_version = GAME_FRAME_LAYOUT_VERSION};
+    memcpy(header.magic, TRACE_MAGIC, sizeof(header.magic)); // NOLINT
+
+    if (fwrite(&header, sizeof(header), 1, file) != 1) {
+        log_error("failed to write trace header");
+        return false;
+    }
+    return true;
+}
+
+bool FrameTrace::write_frame(FILE *file, const GameFrame &frame) {
+    // Field by field, a struct copy may carry the padding of the source
+    GameFrame zeroed;
+    memset(&zeroed, 0, sizeof(zeroed)); // NOLINT
+    zeroed.game_frame = frame.game_frame;
+    copy_player(zeroed.p1, frame.p1);
+    copy_player(zeroed.p2, frame.p2);
+
+    return fwrite(&zeroed, sizeof(zeroed), 1, file) == 1;
+}
+
+bool FrameTrace::dump(const char *path, FILE *output) {
+    FILE *file = fopen(path, "rb");
+    if (file == nullptr) {
+        log_error("failed to open trace file \"%s\"", path);
+        return false;
+    }
+
+    if (!read_header(file)) {
+        (void) fclose(file);
+        return false;
+    }
+
+    GameFrame frame{};
+    char text[FRAME_TEXT_SIZE];
+    while (fread(&frame, sizeof(frame), 1, file) == 1) {
+        format(frame, text, sizeof(text));
+        (void) fprintf(output, "%s\n", text);
+    }
+
+    (void) fclose(file);
+    return true;
+}
@@ -0,0 +1,133 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef FRAME_TRACE_HPP
+#define FRAME_TRACE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+
+#include "game_state_reader.h"
+
+#include "spsc_queue.hpp"
+
+// Enough space for the formatted text of a single frame
+#define FRAME_TEXT_SIZE 2048
+
+struct FrameTraceHeader {
+    char magic[4];
+    uint32_t version;
+    // sizeof(GameFrame) and GAME_FRAME_LAYOUT_VERSION of the writer
+    uint32_t frame_size;
+    uint32_t layout_version;
+};
+
+/**
+ * Binary trace of raw game frames
+ *
+ * Frames are queued without allocating or locking and written to the
+ * trace file by a background thread.
+ */
+class FrameTrace {
+public:
+    FrameTrace() = delete;
+    ~FrameTrace() = delete;
+
+    FrameTrace(const FrameTrace &) = delete;
+    FrameTrace(FrameTrace &&) = delete;
+    FrameTrace &operator=(const FrameTrace &) = delete;
+    FrameTrace &operator=(FrameTrace &&) = delete;
+
+    /**
+     * Open trace file and start the writer thread
+     *
+     * @param path trace file path
+     * @return true on success
+     */
+    static bool start(const char *path);
+    /**
+     * Write queued frames and close the trace file
+     */
+    static void stop();
+    static bool enabled();
+
+    /**
+     * Queue frame for writing (single producer)
+     *
+     * @param frame game frame
+     */
+    static void record(const GameFrame &frame);
+
+    /**
+     * Format frame as text
+     *
+     * @param frame game frame
+     * @param buffer output buffer
+     * @param size output buffer size
+     * @return formatted length
+     */
+    static int format(const GameFrame &frame, char *buffer, const size_t size);
+
+    /**
+     * Print trace file as text
+     *
+     * @param path trace file path
+     * @param output output stream
+     * @return true on success
+     */
+    static bool dump(const char *path, FILE *output);
+
+    /**
+     * Read trace file header
+     *
+     * @param file trace file
+     * @return true if the trace is valid and compatible
+     */
+    static bool read_header(FILE *file);
+
+    /**
+     * Write trace file header
+     *
+     * @param file trace file
+     * @return true on success
+     */
+    static bool write_header(FILE *file);
+
+    /**
+     * Write a frame with zeroed padding, so traces do not depend on stale memory
+     *
+     * @param file trace file
+     * @param frame game frame
+     * @return true on success
+     */
+    static bool write_frame(FILE *file, const GameFrame &frame);
+
+private:
+    static std::atomic<bool> m_running;
+    static std::atomic<uint32_t> m_dropped;
+    static SpscQueue<GameFrame> m_queue;
+    static FILE *m_file;
+    static std::thread m_writer;
+
+    static void writer_loop();
+    static void write_queued();
+};
+
+#endif
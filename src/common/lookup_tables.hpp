@@ -0,0 +1,190 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef LOOKUP_TABLES_HPP
+#define LOOKUP_TABLES_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+template<typename V>
+struct LookupEntry {
+    int32_t key;
+    V value;
+};
+
+/**
+ * Perfect hash table built at compile time from a fixed list of sparse keys
+ *
+ * The hash is a multiplicative hash whose multiplier is searched at compile
+ * time so that every key gets its own slot. Lookup is a single probe.
+ */
+template<typename V, size_t N>
+class PerfectHashTable {
+public:
+    static constexpr size_t SLOT_BITS = [] {
+        size_t bits = 1;
+        while (((size_t) 1 << bits) < N * 2) {
+            bits++;
+        }
+        return bits;
+    }();
+    static constexpr size_t SLOTS = (size_t) 1 << SLOT_BITS;
+
+    constexpr PerfectHashTable(const std::array<LookupEntry<V>, N> &entries, const V fallback) :
+        m_multiplier(find_multiplier(entries)), m_fallback(fallback) {
+        // Empty slots hold a key which hashes elsewhere, so they can never match
+        for (auto &slot : m_slots) {
+            slot = {.key = entries[0].key, .value = fallback};
+        }
+
+        for (const auto &entry : entries) {
+            m_slots[index(entry.key)] = entry;
+        }
+    }
+
+    /**
+     * Find value for key
+     *
+     * @param key key
+     * @return value or fallback if the key is unknown
+     */
+    [[nodiscard]] constexpr V get(const int32_t key) const {
+        const LookupEntry<V> &slot = m_slots[index(key)];
+        return slot.key == key ? slot.value : m_fallback;
+    }
+
+    /**
+     * Check if the key is part of the table
+     *
+     * @param key key
+     * @return true if found
+     */
+    [[nodiscard]] constexpr bool contains(const int32_t key) const {
+        return m_slots[index(key)].key == key;
+    }
+
+private:
+    std::array<LookupEntry<V>, SLOTS> m_slots{};
+    uint32_t m_multiplier;
+    V m_fallback;
+
+    [[nodiscard]] static constexpr size_t hash(const int32_t key, const uint32_t multiplier) {
+        return ((uint32_t) key * multiplier) >> (32 - SLOT_BITS);
+    }
+
+    [[nodiscard]] constexpr size_t index(const int32_t key) const {
+        return hash(key, m_multiplier);
+    }
+
+    static constexpr uint32_t find_multiplier(const std::array<LookupEntry<V>, N> &entries) {
+        // Odd multipliers from a Weyl sequence of the golden ratio
+        uint32_t multiplier = 0x9E3779B1U;
+        for (int attempt = 0; attempt < 100000; attempt++) {
+            bool collision = false;
+            std::array<bool, SLOTS> used{};
+            for (const auto &entry : entries) {
+                const size_t slot = hash(entry.key, multiplier);
+                if (used[slot]) {
+                    collision = true;
+                    break;
+                }
+                used[slot] = true;
+            }
+
+            if (!collision) {
+                return multiplier;
+            }
+            multiplier += 0x6A09E668U;
+        }
+
+        // Not a constant expression: fails the build if no multiplier exists
+        throw "no perfect hash multiplier found";
+    }
+};
+
+/**
+ * Fixed size counter for ids which were not found from lookup tables
+ *
+ * Thread-safe, never allocates. Slots are claimed in order with a CAS on the
+ * key, sightings of ids which do not fit are only counted.
+ */
+template<size_t N>
+class UnknownIdCounter {
+public:
+    /**
+     * Count unknown id
+     *
+     * @param id unknown id
+     * @return true if the id was seen for the first time
+     */
+    bool record(const int32_t id) {
+        const uint64_t id_key = OCCUPIED | (uint32_t) id;
+        for (size_t i = 0; i < N; i++) {
+            uint64_t key = m_keys[i].load(std::memory_order_acquire);
+            // Claim the first free slot, a racing thread may claim it for the same id
+            if (key == 0 && m_keys[i].compare_exchange_strong(key, id_key, std::memory_order_acq_rel)) {
+                m_hits[i].fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+
+            if (key == id_key) {
+                m_hits[i].fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        }
+
+        m_untracked_sightings.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    [[nodiscard]] size_t size() const {
+        // Slots are claimed in order
+        size_t count = 0;
+        while (count < N && m_keys[count].load(std::memory_order_acquire) != 0) {
+            count++;
+        }
+        return count;
+    }
+
+    [[nodiscard]] int32_t id(const size_t index) const {
+        return (int32_t) (uint32_t) m_keys[index].load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] uint32_t hits(const size_t index) const {
+        return m_hits[index].load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @return times an id was recorded after the table was full, not distinct ids
+     */
+    [[nodiscard]] uint32_t untracked_sightings() const {
+        return m_untracked_sightings.load(std::memory_order_relaxed);
+    }
+
+private:
+    // Keys hold the id and an occupied bit, zero is a free slot
+    static constexpr uint64_t OCCUPIED = (uint64_t) 1 << 32;
+
+    std::array<std::atomic<uint64_t>, N> m_keys{};
+    std::array<std::atomic<uint32_t>, N> m_hits{};
+    std::atomic<uint32_t> m_untracked_sightings = 0;
+};
+
+#endif
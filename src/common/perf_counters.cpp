@@ -0,0 +1,123 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "perf_counters.hpp"
+
+#include <cstdio>
+
+#include "logging.h"
+
+bool PerfCounters::m_enabled = false;
+bool PerfCounters::m_attached = false;
+bool PerfCounters::m_hardware = false;
+bool PerfCounters::m_kernel = false;
+PerfSample PerfCounters::m_last = {};
+PerfSample PerfCounters::m_totals[PERF_MAX_STAGES] = {};
+uint64_t PerfCounters::m_laps[PERF_MAX_STAGES] = {};
+
+void PerfCounters::enable() {
+    m_enabled = true;
+}
+
+bool PerfCounters::attach_thread() {
+    if (!m_enabled || m_attached) {
+        return m_attached;
+    }
+
+    if (!open_counters()) {
+        log_error("performance counters are not available");
+        return false;
+    }
+
+    m_attached = true;
+    log_info("counting analyser thread events%s", m_hardware ? "" : ", hardware counters not available");
+    if (!m_kernel) {
+        log_warn("kernel events not permitted, counting user space only: context switches from getrusage, "
+                 "migrations not available");
+    }
+    return true;
+}
+
+void PerfCounters::lap(const size_t stage) {
+    PerfSample now{};
+    read_counters(now);
+
+    PerfSample &total = m_totals[stage];
+    for (size_t i = 0; i < PERF_COUNTER_COUNT; i++) {
+        total.values[i] += now.values[i] - m_last.values[i];
+    }
+    m_laps[stage]++;
+    m_last = now;
+}
+
+const PerfSample &PerfCounters::stage_total(const size_t stage) {
+    return m_totals[stage];
+}
+
+uint64_t PerfCounters::stage_laps(const size_t stage) {
+    return m_laps[stage];
+}
+
+void PerfCounters::log_summary(const char *const *names, const size_t stages) {
+    log_info("perf counters: %-12s %10s %12s %12s %6s %10s %12s %12s %12s",
+             "stage",
+             "laps",
+             "cycles",
+             "instructions",
+             "IPC",
+             "cache miss",
+             "ctx switches",
+             "migrations",
+             "page faults");
+
+    for (size_t stage = 0; stage < stages && stage < PERF_MAX_STAGES; stage++) {
+        const uint64_t laps = m_laps[stage];
+        if (laps == 0) {
+            continue;
+        }
+
+        // Per lap averages, switches, migrations and faults are rare enough to show as totals
+        const uint64_t *values = m_totals[stage].values;
+        char hardware[64] = "           -            -      -          -";
+        if (m_hardware) {
+            const double cycles = (double) values[PERF_CYCLES];
+            (void) snprintf(hardware, // NOLINT
+                            sizeof(hardware),
+                            "%12.0f %12.0f %6.2f %10.1f",
+                            cycles / (double) laps,
+                            (double) values[PERF_INSTRUCTIONS] / (double) laps,
+                            cycles > 0 ? (double) values[PERF_INSTRUCTIONS] / cycles : 0.0,
+                            (double) values[PERF_CACHE_MISSES] / (double) laps);
+        }
+
+        char migrations[16] = "           -";
+        if (m_kernel) {
+            (void) snprintf(migrations, // NOLINT
+                            sizeof(migrations),
+                            "%12llu",
+                            (unsigned long long) values[PERF_CPU_MIGRATIONS]);
+        }
+
+        log_info("perf counters: %-12s %10llu %s %12llu %s %12llu",
+                 names[stage], // NOLINT
+                 (unsigned long long) laps,
+                 hardware,
+                 (unsigned long long) values[PERF_CONTEXT_SWITCHES],
+                 migrations,
+                 (unsigned long long) values[PERF_PAGE_FAULTS]);
+    }
+}
@@ -0,0 +1,131 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef PERF_COUNTERS_HPP
+#define PERF_COUNTERS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+// Stages counters are aggregated by, see TickStage
+#define PERF_MAX_STAGES 16
+
+enum PerfCounter : uint8_t {
+    // Hardware, unavailable in most virtual machines
+    PERF_CYCLES,
+    PERF_INSTRUCTIONS,
+    PERF_CACHE_MISSES,
+    // Software
+    PERF_CONTEXT_SWITCHES,
+    PERF_CPU_MIGRATIONS,
+    PERF_PAGE_FAULTS,
+    PERF_COUNTER_COUNT
+};
+
+// Counter values of a group read
+struct PerfSample {
+    uint64_t values[PERF_COUNTER_COUNT];
+};
+
+/**
+ * Hardware and software event counters of the analyser thread
+ *
+ * Counters are read at every tick profiler mark and the deltas summed per
+ * stage. Hardware counters are skipped where they cannot be opened, the
+ * software counters are enough to see context switches and migrations.
+ * Without permission to count kernel events (perf_event_paranoid 2 for
+ * unprivileged users) context switches are taken from getrusage and
+ * migrations are reported as unavailable.
+ */
+class PerfCounters {
+public:
+    PerfCounters() = delete;
+    ~PerfCounters() = delete;
+
+    PerfCounters(const PerfCounters &) = delete;
+    PerfCounters(PerfCounters &&) = delete;
+    PerfCounters &operator=(const PerfCounters &) = delete;
+    PerfCounters &operator=(PerfCounters &&) = delete;
+
+    /**
+     * Count the analyser thread once it attaches
+     */
+    static void enable();
+    /**
+     * Open counters for the calling thread if enabled, the analyser thread calls this on start.
+     * Counters stay open until exit, later calls from the same thread are no-ops.
+     *
+     * @return true if at least the software counters are counting
+     */
+    static bool attach_thread();
+    static bool attached() {
+        return m_attached;
+    }
+    static bool hardware_available() {
+        return m_hardware;
+    }
+    /**
+     * @return false if only user space events are counted, context switches then come from
+     *         the thread's resource usage and migrations are not available
+     */
+    static bool kernel_counted() {
+        return m_kernel;
+    }
+
+    /**
+     * Start a tick, reads the counters (attached thread only)
+     */
+    static void begin() {
+        read_counters(m_last);
+    }
+    /**
+     * Add counts since the previous read to the stage (attached thread only)
+     *
+     * @param stage stage index below PERF_MAX_STAGES
+     */
+    static void lap(const size_t stage);
+
+    /**
+     * @param stage stage index
+     * @return counts summed over the stage's laps
+     */
+    static const PerfSample &stage_total(const size_t stage);
+    static uint64_t stage_laps(const size_t stage);
+
+    /**
+     * Log the average counts per tick of every stage
+     *
+     * @param names stage names
+     * @param stages stage count
+     */
+    static void log_summary(const char *const *names, const size_t stages);
+
+private:
+    static bool m_enabled;
+    static bool m_attached;
+    static bool m_hardware;
+    static bool m_kernel;
+    static PerfSample m_last;
+    static PerfSample m_totals[PERF_MAX_STAGES];
+    static uint64_t m_laps[PERF_MAX_STAGES];
+
+    // Platform specific
+    static bool open_counters();
+    static void read_counters(PerfSample &sample);
+};
+
+#endif
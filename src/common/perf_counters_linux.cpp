@@ -0,0 +1,150 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "perf_counters.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "logging.h"
+
+namespace {
+struct CounterConfig {
+    uint32_t type;
+    uint64_t config;
+    PerfCounter counter;
+};
+
+constexpr CounterConfig HARDWARE_COUNTERS[] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, PERF_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, PERF_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, PERF_CACHE_MISSES},
+};
+
+constexpr CounterConfig SOFTWARE_COUNTERS[] = {
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES, PERF_CONTEXT_SWITCHES},
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CPU_MIGRATIONS, PERF_CPU_MIGRATIONS},
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS, PERF_PAGE_FAULTS},
+};
+
+constexpr size_t GROUP_SIZE = 3;
+
+// A group is read with a single read call
+struct CounterGroup {
+    int fds[GROUP_SIZE];
+    size_t count;
+};
+
+// Group read layout of PERF_FORMAT_GROUP
+struct GroupRead {
+    uint64_t count;
+    uint64_t values[GROUP_SIZE];
+};
+
+CounterGroup g_hardware = {{-1, -1, -1}, 0};
+CounterGroup g_software = {{-1, -1, -1}, 0};
+
+int perf_event_open(perf_event_attr *attr, const int group_fd) {
+    // Calling thread on any CPU
+    return (int) syscall(SYS_perf_event_open, attr, 0, -1, group_fd, 0);
+}
+
+void close_group(CounterGroup &group) {
+    for (size_t i = 0; i < group.count; i++) {
+        (void) close(group.fds[i]);
+        group.fds[i] = -1;
+    }
+    group.count = 0;
+}
+
+bool open_group(CounterGroup &group, const CounterConfig *counters, const bool exclude_kernel) {
+    for (size_t i = 0; i < GROUP_SIZE; i++) {
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = counters[i].type; // NOLINT
+        attr.config = counters[i].config; // NOLINT
+        attr.read_format = PERF_FORMAT_GROUP;
+        attr.disabled = i == 0 ? 1 : 0;
+        attr.exclude_kernel = exclude_kernel ? 1 : 0;
+        attr.exclude_hv = 1;
+
+        const int fd = perf_event_open(&attr, i == 0 ? -1 : group.fds[0]);
+        if (fd == -1) {
+            log_debug("perf_event_open failed for counter %d: %s", counters[i].counter, strerror(errno)); // NOLINT
+            close_group(group);
+            return false;
+        }
+        group.fds[i] = fd;
+        group.count = i + 1;
+    }
+
+    (void) ioctl(group.fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    (void) ioctl(group.fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return true;
+}
+
+/**
+ * Open a group, retries user space only counting when kernel counting is not permitted
+ *
+ * @param kernel set to true if kernel events are counted
+ */
+bool open_group(CounterGroup &group, const CounterConfig *counters, bool *kernel) {
+    *kernel = open_group(group, counters, false);
+    return *kernel || open_group(group, counters, true);
+}
+
+void read_group(const CounterGroup &group, const CounterConfig *counters, PerfSample &sample) {
+    if (group.count == 0) {
+        return;
+    }
+
+    GroupRead values{};
+    if (read(group.fds[0], &values, sizeof(values)) <= 0) {
+        return;
+    }
+    for (size_t i = 0; i < values.count && i < GROUP_SIZE; i++) {
+        sample.values[counters[i].counter] = values.values[i]; // NOLINT
+    }
+}
+} // namespace
+
+bool PerfCounters::open_counters() {
+    bool hardware_kernel = false;
+    m_hardware = open_group(g_hardware, HARDWARE_COUNTERS, &hardware_kernel);
+    const bool software = open_group(g_software, SOFTWARE_COUNTERS, &m_kernel);
+    return software || m_hardware;
+}
+
+void PerfCounters::read_counters(PerfSample &sample) {
+    read_group(g_hardware, HARDWARE_COUNTERS, sample);
+    read_group(g_software, SOFTWARE_COUNTERS, sample);
+
+    // Switches and migrations happen in the kernel, user space only counters never see them
+    if (!m_kernel) {
+        rusage usage{};
+        if (getrusage(RUSAGE_THREAD, &usage) == 0) {
+            sample.values[PERF_CONTEXT_SWITCHES] = (uint64_t) (usage.ru_nvcsw + usage.ru_nivcsw);
+        }
+        sample.values[PERF_CPU_MIGRATIONS] = 0;
+    }
+}
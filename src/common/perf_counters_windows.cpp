@@ -0,0 +1,28 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "perf_counters.hpp"
+
+// No per-thread event counters without a kernel driver, attaching fails
+
+bool PerfCounters::open_counters() {
+    m_hardware = false;
+    m_kernel = false;
+    return false;
+}
+
+void PerfCounters::read_counters(PerfSample & /*sample*/) {}
@@ -0,0 +1,85 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "runtime_features.hpp"
+
+#include "logging.h"
+#include "read_stats.h"
+
+#include "event_server.hpp"
+#include "frame_data_analyser.hpp"
+#include "frame_exporter.hpp"
+#include "frame_trace.hpp"
+#include "perf_counters.hpp"
+#include "shadow_analyser.hpp"
+#include "span_tracer.hpp"
+#include "tick_profiler.hpp"
+
+void RuntimeFeatures::start(const Configuration &config) {
+    log_set_level(config.log_level);
+    if (config.async_logging && log_start_async() != 0) {
+        log_error("failed to start asynchronous logging");
+    }
+    FrameDataAnalyser::set_logging(config.frame_data_logging);
+
+    if (config.trace_file != nullptr && !FrameTrace::start(config.trace_file)) {
+        log_error("frame tracing disabled");
+    }
+
+    if (config.shared_memory && !FrameExporter::start(FRAME_EXPORT_NAME)) {
+        log_error("shared memory export disabled");
+    }
+
+    if (config.event_socket != nullptr && !EventServer::start(config.event_socket)) {
+        log_error("event socket disabled");
+    }
+
+    if (config.shadow_analyser != nullptr && !ShadowAnalyser::start(config.shadow_analyser)) {
+        log_error("shadow analyser disabled");
+    }
+
+    if (config.tick_profile) {
+        TickProfiler::enable(TICK_LENGTH);
+    }
+
+    if (config.perf_counters) {
+        PerfCounters::enable();
+    }
+
+    if (config.read_stats) {
+        read_stats_enable();
+    }
+
+    if (config.span_trace != nullptr && !SpanTracer::start(config.span_trace)) {
+        log_error("span tracing disabled");
+    }
+}
+
+void RuntimeFeatures::stop() {
+    FrameTrace::stop();
+    FrameExporter::stop();
+    EventServer::stop();
+    ShadowAnalyser::stop();
+    SpanTracer::stop();
+    if (TickProfiler::enabled()) {
+        TickProfiler::log_summary();
+    }
+    if (read_stats_enabled() != 0) {
+        read_stats_log_summary();
+    }
+    log_stop_async();
+}
@@ -0,0 +1,50 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef RUNTIME_FEATURES_HPP
+#define RUNTIME_FEATURES_HPP
+
+#include "arg_parser.hpp"
+
+/**
+ * Starts and stops the optional features of the configuration, shared by the frontends
+ */
+class RuntimeFeatures {
+public:
+    RuntimeFeatures() = delete;
+    ~RuntimeFeatures() = delete;
+
+    RuntimeFeatures(const RuntimeFeatures &) = delete;
+    RuntimeFeatures(RuntimeFeatures &&) = delete;
+    RuntimeFeatures &operator=(const RuntimeFeatures &) = delete;
+    RuntimeFeatures &operator=(RuntimeFeatures &&) = delete;
+
+    /**
+     * Apply logging options and start the configured features, a feature which
+     * fails to start is disabled
+     *
+     * @param config configuration
+     */
+    static void start(const Configuration &config);
+    /**
+     * Stop the features, log their summaries and stop asynchronous logging,
+     * call after the analyser has stopped
+     */
+    static void stop();
+};
+
+#endif
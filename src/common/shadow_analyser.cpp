@@ -0,0 +1,277 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "shadow_analyser.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#include "frame_trace.hpp"
+#include "logging.h"
+#include "shadow_candidate.h"
+
+// Constants
+// Roughly 8 seconds of analyser ticks
+#define SHADOW_QUEUE_SIZE 1024
+#define SHADOW_COMPARE_INTERVAL_MS 50
+// Divergences logged with their frame window, the rest are only counted
+#define SHADOW_MAX_LOGGED 10
+// Compared events, hook and resync come from the game connection, not the analysis
+#define SHADOW_COMPARED_EVENTS (TICK_FRAME_DATA | TICK_DISTANCE | TICK_STATUS)
+
+std::atomic<bool> ShadowAnalyser::m_running = false;
+std::atomic<uint32_t> ShadowAnalyser::m_dropped = 0;
+SpscQueue<ShadowTick> ShadowAnalyser::m_queue(SHADOW_QUEUE_SIZE);
+std::thread ShadowAnalyser::m_thread;
+ShadowTick ShadowAnalyser::m_pending = {};
+ShadowCandidate ShadowAnalyser::m_candidate = {};
+RingBuffer<GameFrame> ShadowAnalyser::m_window(SHADOW_WINDOW_SIZE);
+uint64_t ShadowAnalyser::m_ticks = 0;
+uint64_t ShadowAnalyser::m_divergences = 0;
+int64_t ShadowAnalyser::m_reference_ns = 0;
+int64_t ShadowAnalyser::m_candidate_ns = 0;
+
+namespace {
+bool events_equal(const TickEvents &reference, const TickEvents &candidate) {
+    const uint8_t changed = reference.changed & SHADOW_COMPARED_EVENTS;
+    if (changed != (candidate.changed & SHADOW_COMPARED_EVENTS)) {
+        return false;
+    }
+
+    if ((changed & TICK_FRAME_DATA) != 0 &&
+        (reference.frame_data.startup_frames != candidate.frame_data.startup_frames ||
+         reference.frame_data.frame_advantage != candidate.frame_data.frame_advantage ||
+         reference.frame_data.knock_down != candidate.frame_data.knock_down)) {
+        return false;
+    }
+
+    if ((changed & TICK_DISTANCE) != 0 && reference.distance != candidate.distance) {
+        return false;
+    }
+
+    return (changed & TICK_STATUS) == 0 || reference.status == candidate.status;
+}
+
+// Drop events with nothing compared in place, returns the remaining count
+uint32_t keep_compared(TickEvents *events, const size_t count) {
+    uint32_t kept = 0;
+    for (size_t i = 0; i < count; i++) {
+        if ((events[i].changed & SHADOW_COMPARED_EVENTS) != 0) { // NOLINT
+            events[kept++] = events[i]; // NOLINT
+        }
+    }
+    return kept;
+}
+
+int format_events(const TickEvents &events, char *buffer, const size_t size) {
+    return snprintf(buffer, // NOLINT
+                    size,
+                    "changed: 0x%02x, startup: %d, advantage: %d, KD: %d, distance: %.3f, status: %d",
+                    events.changed & SHADOW_COMPARED_EVENTS,
+                    events.frame_data.startup_frames,
+                    events.frame_data.frame_advantage,
+                    events.frame_data.knock_down,
+                    events.distance,
+                    (int) events.status);
+}
+} // namespace
+
+bool ShadowAnalyser::start(const char *path) {
+    if (m_running) {
+        return true;
+    }
+
+    if (!load_candidate(path)) {
+        return false;
+    }
+
+    m_window.clear();
+    m_pending = {};
+    m_dropped = 0;
+    m_ticks = 0;
+    m_divergences = 0;
+    m_reference_ns = 0;
+    m_candidate_ns = 0;
+    m_running = true;
+    m_thread = std::thread(&shadow_loop);
+
+    log_info("shadowing analyser with \"%s\"", path);
+    return true;
+}
+
+void ShadowAnalyser::stop() {
+    if (!m_running) {
+        return;
+    }
+
+    m_running = false;
+    m_thread.join();
+    compare_queued();
+
+    const double ticks = m_ticks > 0 ? (double) m_ticks : 1;
+    log_info("shadow analyser: %llu ticks, %llu divergences, reference %.0f ns/tick, candidate %.0f ns/tick",
+             (unsigned long long) m_ticks,
+             (unsigned long long) m_divergences,
+             (double) m_reference_ns / ticks,
+             (double) m_candidate_ns / ticks);
+    if (m_dropped > 0) {
+        log_warn("shadow analyser dropped %u ticks, later divergences may be spurious", m_dropped.load());
+    }
+
+    unload_library(m_candidate.library);
+    m_candidate = {};
+}
+
+bool ShadowAnalyser::enabled() {
+    return m_running.load(std::memory_order_relaxed);
+}
+
+uint64_t ShadowAnalyser::divergences() {
+    return m_divergences;
+}
+
+void ShadowAnalyser::seed(const GameFrame &frame) {
+    m_pending.event_count = 0;
+    if (!m_queue.push({.frame = frame, .events = {}, .event_count = 0, .reference_ns = 0, .seed = true})) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void ShadowAnalyser::add_events(const TickEvents &events) {
+    if ((events.changed & SHADOW_COMPARED_EVENTS) == 0) {
+        return;
+    }
+
+    // Keep the latest publish if a tick ever exceeds the slots, the comparison then reports it
+    const uint32_t slot = std::min(m_pending.event_count, (uint32_t) SHADOW_TICK_EVENTS - 1);
+    m_pending.events[slot] = events; // NOLINT
+    m_pending.event_count = slot + 1;
+}
+
+void ShadowAnalyser::record(const GameFrame &frame, const int64_t reference_ns) {
+    m_pending.frame = frame;
+    m_pending.reference_ns = reference_ns;
+    m_pending.seed = false;
+    if (!m_queue.push(m_pending)) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+    m_pending.event_count = 0;
+}
+
+bool ShadowAnalyser::load_candidate(const char *path) {
+    void *library = load_library(path);
+    if (library == nullptr) {
+        return false;
+    }
+
+    auto abi_version = (int (*)()) find_symbol(library, "shadow_candidate_abi_version"); // NOLINT
+    auto frame_size = (size_t (*)()) find_symbol(library, "shadow_candidate_frame_size"); // NOLINT
+    auto events_size = (size_t (*)()) find_symbol(library, "shadow_candidate_events_size"); // NOLINT
+    m_candidate = {.library = library,
+                   .reset = (void (*)()) find_symbol(library, "shadow_candidate_reset"), // NOLINT
+                   .seed = (void (*)(const GameFrame *)) find_symbol(library, "shadow_candidate_seed"), // NOLINT
+                   .process = (size_t (*)(const GameFrame *, TickEvents *, size_t)) find_symbol( // NOLINT
+                       library,
+                       "shadow_candidate_process")};
+
+    if (abi_version == nullptr || frame_size == nullptr || events_size == nullptr || m_candidate.reset == nullptr ||
+        m_candidate.seed == nullptr || m_candidate.process == nullptr) {
+        log_error("\"%s\" is not a shadow analyser candidate", path);
+    } else if (abi_version() != SHADOW_CANDIDATE_ABI_VERSION || frame_size() != sizeof(GameFrame) ||
+               events_size() != sizeof(TickEvents)) {
+        log_error("incompatible shadow analyser candidate (ABI version %d)", abi_version());
+    } else {
+        return true;
+    }
+
+    unload_library(library);
+    m_candidate = {};
+    return false;
+}
+
+void ShadowAnalyser::shadow_loop() {
+    while (m_running) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(SHADOW_COMPARE_INTERVAL_MS));
+        compare_queued();
+    }
+}
+
+void ShadowAnalyser::compare_queued() {
+    ShadowTick tick{};
+    while (m_queue.pop(tick)) {
+        compare(tick);
+    }
+}
+
+void ShadowAnalyser::compare(const ShadowTick &tick) {
+    if (tick.seed) {
+        m_window.clear();
+        m_window.push(tick.frame);
+        m_candidate.reset();
+        m_candidate.seed(&tick.frame);
+        return;
+    }
+
+    m_window.push(tick.frame);
+
+    TickEvents events[SHADOW_TICK_EVENTS]{};
+    const auto start = std::chrono::steady_clock::now();
+    const size_t stored = m_candidate.process(&tick.frame, events, SHADOW_TICK_EVENTS);
+    const auto end = std::chrono::steady_clock::now();
+    const uint32_t count = keep_compared(events, std::min(stored, (size_t) SHADOW_TICK_EVENTS));
+
+    m_ticks++;
+    m_reference_ns += tick.reference_ns;
+    m_candidate_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+    bool equal = count == tick.event_count;
+    for (uint32_t i = 0; equal && i < count; i++) {
+        equal = events_equal(tick.events[i], events[i]); // NOLINT
+    }
+
+    if (!equal) {
+        m_divergences++;
+        if (m_divergences <= SHADOW_MAX_LOGGED) {
+            log_divergence(tick, events, count);
+        }
+    }
+}
+
+void ShadowAnalyser::log_divergence(const ShadowTick &tick, const TickEvents *candidate, const uint32_t count) {
+    char text[FRAME_TEXT_SIZE];
+    log_warn("shadow analyser diverged on frame %u", tick.frame.game_frame);
+
+    for (uint32_t i = 0; i < tick.event_count; i++) {
+        format_events(tick.events[i], text, sizeof(text)); // NOLINT
+        log_warn("reference %s", text);
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        format_events(candidate[i], text, sizeof(text)); // NOLINT
+        log_warn("candidate %s", text);
+    }
+
+    // Oldest frame first
+    for (size_t i = m_window.item_count(); i > 0; i--) {
+        FrameTrace::format(*m_window.get_from_head(i - 1), text, sizeof(text));
+        log_warn("%s", text);
+    }
+
+    if (m_divergences == SHADOW_MAX_LOGGED) {
+        log_warn("shadow analyser logged %d divergences, counting the rest", SHADOW_MAX_LOGGED);
+    }
+}
@@ -0,0 +1,130 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef SHADOW_ANALYSER_HPP
+#define SHADOW_ANALYSER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include "frame_data_analyser.hpp"
+#include "ring_buffer.hpp"
+#include "spsc_queue.hpp"
+
+// Frames logged before a divergence
+#define SHADOW_WINDOW_SIZE 8
+// Compared publishes of a single tick, two frame data results at most
+#define SHADOW_TICK_EVENTS 4
+
+struct ShadowTick {
+    GameFrame frame;
+    // Compared events published during the tick, in order
+    TickEvents events[SHADOW_TICK_EVENTS];
+    uint32_t event_count;
+    int64_t reference_ns;
+    // Resets the candidate and seeds its history, not analysed
+    bool seed;
+};
+
+struct ShadowCandidate {
+    void *library;
+    void (*reset)();
+    void (*seed)(const GameFrame *frame);
+    size_t (*process)(const GameFrame *frame, TickEvents *events, size_t capacity);
+};
+
+/**
+ * Shadow mode, runs a candidate analyser module next to the reference
+ *
+ * Frames and the events the reference emitted for them are queued without
+ * blocking the analyser. A background thread feeds them to the candidate,
+ * compares the emitted events tick by tick and measures the cost of both.
+ */
+class ShadowAnalyser {
+public:
+    ShadowAnalyser() = delete;
+    ~ShadowAnalyser() = delete;
+
+    ShadowAnalyser(const ShadowAnalyser &) = delete;
+    ShadowAnalyser(ShadowAnalyser &&) = delete;
+    ShadowAnalyser &operator=(const ShadowAnalyser &) = delete;
+    ShadowAnalyser &operator=(ShadowAnalyser &&) = delete;
+
+    /**
+     * Load the candidate module and start the shadow thread
+     *
+     * @param path candidate module path
+     * @return true on success
+     */
+    static bool start(const char *path);
+    /**
+     * Compare queued ticks, log the summary and unload the candidate
+     */
+    static void stop();
+    static bool enabled();
+    /**
+     * @return divergent ticks of the last run, valid after stop
+     */
+    static uint64_t divergences();
+
+    /**
+     * Queue the first frame of the reference's history (analyser thread only)
+     *
+     * @param frame side flipped game frame
+     */
+    static void seed(const GameFrame &frame);
+    /**
+     * Collect events the reference published during the current tick (analyser thread only)
+     *
+     * @param events published events
+     */
+    static void add_events(const TickEvents &events);
+    /**
+     * Queue an analysed frame with the events collected for it (analyser thread only)
+     *
+     * @param frame side flipped game frame
+     * @param reference_ns reference analysis time
+     */
+    static void record(const GameFrame &frame, const int64_t reference_ns);
+
+private:
+    static std::atomic<bool> m_running;
+    static std::atomic<uint32_t> m_dropped;
+    static SpscQueue<ShadowTick> m_queue;
+    static std::thread m_thread;
+    static ShadowTick m_pending;
+    static ShadowCandidate m_candidate;
+    static RingBuffer<GameFrame> m_window;
+    static uint64_t m_ticks;
+    static uint64_t m_divergences;
+    static int64_t m_reference_ns;
+    static int64_t m_candidate_ns;
+
+    // Platform specific
+    static void *load_library(const char *path);
+    static void *find_symbol(void *library, const char *name);
+    static void unload_library(void *library);
+
+    static bool load_candidate(const char *path);
+    static void shadow_loop();
+    static void compare_queued();
+    static void compare(const ShadowTick &tick);
+    static void log_divergence(const ShadowTick &tick, const TickEvents *candidate, const uint32_t count);
+};
+
+#endif
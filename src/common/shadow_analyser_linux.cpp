@@ -0,0 +1,41 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "shadow_analyser.hpp"
+
+#include <dlfcn.h>
+
+#include "logging.h"
+
+void *ShadowAnalyser::load_library(const char *path) {
+    // Local binding keeps the candidate's analyser statics apart from the reference's
+    void *library = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+    if (library == nullptr) {
+        log_error("failed to load shadow analyser candidate: %s", dlerror());
+    }
+    return library;
+}
+
+void *ShadowAnalyser::find_symbol(void *library, const char *name) {
+    return dlsym(library, name);
+}
+
+void ShadowAnalyser::unload_library(void *library) {
+    if (library != nullptr) {
+        dlclose(library);
+    }
+}
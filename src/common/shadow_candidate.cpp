@@ -0,0 +1,71 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "shadow_candidate.h"
+
+#include "logging.h"
+
+namespace {
+class CaptureListener : public EventListener {
+public:
+    TickEvents *events = nullptr;
+    size_t capacity = 0;
+    size_t count = 0;
+
+    void tick(const TickEvents &tick_events) override {
+        if (count < capacity) {
+            events[count++] = tick_events; // NOLINT
+        }
+    }
+};
+
+CaptureListener g_listener;
+} // namespace
+
+extern "C" {
+SHADOW_CANDIDATE_EXPORT int shadow_candidate_abi_version(void) {
+    return SHADOW_CANDIDATE_ABI_VERSION;
+}
+
+SHADOW_CANDIDATE_EXPORT size_t shadow_candidate_frame_size(void) {
+    return sizeof(GameFrame);
+}
+
+SHADOW_CANDIDATE_EXPORT size_t shadow_candidate_events_size(void) {
+    return sizeof(TickEvents);
+}
+
+SHADOW_CANDIDATE_EXPORT void shadow_candidate_reset(void) {
+    // Diagnostics would repeat the reference's, divergences are logged by the host
+    log_set_quiet(true);
+    FrameDataAnalyser::reset(&g_listener);
+}
+
+SHADOW_CANDIDATE_EXPORT void shadow_candidate_seed(const GameFrame *frame) {
+    FrameDataAnalyser::push_frame(*frame);
+}
+
+SHADOW_CANDIDATE_EXPORT size_t shadow_candidate_process(const GameFrame *frame,
+                                                        TickEvents *events,
+                                                        const size_t capacity) {
+    g_listener.events = events;
+    g_listener.capacity = capacity;
+    g_listener.count = 0;
+    FrameDataAnalyser::process_frame(*frame);
+    return g_listener.count;
+}
+}
@@ -0,0 +1,72 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/*
+  Entry points of a candidate analyser module for shadow mode
+
+  The module is the analyser built as a shared library (shadow_candidate
+  target) from the tree under test. It has its own copy of the analyser
+  state, the host feeds it every frame the reference analyser sees.
+*/
+
+#ifndef SHADOW_CANDIDATE_H
+#define SHADOW_CANDIDATE_H
+
+#include "frame_data_analyser.hpp"
+#include "game_state_reader.h"
+
+#ifdef _WIN32
+#define SHADOW_CANDIDATE_EXPORT __declspec(dllexport)
+#else
+#define SHADOW_CANDIDATE_EXPORT __attribute__((visibility("default")))
+#endif
+
+// Bumped when the entry points or the structures passed through them change
+#define SHADOW_CANDIDATE_ABI_VERSION 2
+
+extern "C" {
+/**
+ * @return ABI version, compatible if equal to SHADOW_CANDIDATE_ABI_VERSION
+ */
+SHADOW_CANDIDATE_EXPORT int shadow_candidate_abi_version(void);
+/**
+ * @return sizes of GameFrame and TickEvents in the module for a layout check
+ */
+SHADOW_CANDIDATE_EXPORT size_t shadow_candidate_frame_size(void);
+SHADOW_CANDIDATE_EXPORT size_t shadow_candidate_events_size(void);
+/**
+ * Clear analysis state
+ */
+SHADOW_CANDIDATE_EXPORT void shadow_candidate_reset(void);
+/**
+ * Add frame to the history without analysing it, the first frame on hook-up
+ */
+SHADOW_CANDIDATE_EXPORT void shadow_candidate_seed(const struct GameFrame *frame);
+/**
+ * Analyse a single frame
+ *
+ * @param frame side flipped game frame
+ * @param events events published for the frame, in order
+ * @param capacity size of events
+ * @return number of events stored
+ */
+SHADOW_CANDIDATE_EXPORT size_t shadow_candidate_process(const struct GameFrame *frame,
+                                                        struct TickEvents *events,
+                                                        size_t capacity);
+}
+
+#endif
@@ -0,0 +1,197 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "span_tracer.hpp"
+
+#include <csignal>
+
+#include "logging.h"
+
+// Constants
+#define SPAN_WRITE_POLL_MS 100
+
+std::atomic<bool> SpanTracer::m_running = false;
+std::atomic<bool> SpanTracer::m_write_requested = false;
+std::atomic<size_t> SpanTracer::m_thread_count = 0;
+std::atomic<uint32_t> SpanTracer::m_dropped_threads = 0;
+std::atomic<SpanBuffer *> SpanTracer::m_threads[SPAN_MAX_THREADS] = {};
+thread_local SpanBuffer *SpanTracer::t_buffer = nullptr;
+thread_local bool SpanTracer::t_dropped = false;
+const char *SpanTracer::m_path = nullptr;
+std::thread SpanTracer::m_writer;
+
+namespace {
+#ifdef SIGUSR2
+void write_signal(int /*signal*/) {
+    SpanTracer::request_write();
+}
+#endif
+} // namespace
+
+bool SpanTracer::start(const char *path) {
+    if (m_running) {
+        return true;
+    }
+
+    // Fail early instead of losing the trace at exit
+    FILE *file = fopen(path, "w");
+    if (file == nullptr) {
+        log_error("failed to open span trace file \"%s\"", path);
+        return false;
+    }
+    (void) fclose(file);
+
+    m_path = path;
+    m_running = true;
+    m_writer = std::thread(&writer_loop);
+
+#ifdef SIGUSR2
+    (void) signal(SIGUSR2, &write_signal);
+    log_info("tracing spans to \"%s\", send SIGUSR2 to write it", path);
+#else
+    log_info("tracing spans to \"%s\"", path);
+#endif
+    return true;
+}
+
+void SpanTracer::stop() {
+    if (!m_running) {
+        return;
+    }
+
+    m_running = false;
+    m_writer.join();
+    if (write_file()) {
+        log_info("span trace written to \"%s\"", m_path);
+    }
+
+    if (m_dropped_threads > 0) {
+        log_warn("span trace dropped spans of %u threads", m_dropped_threads.load());
+    }
+}
+
+void SpanTracer::set_thread_name(const char *name) {
+    if (!enabled()) {
+        return;
+    }
+
+    SpanBuffer *buffer = thread_buffer();
+    if (buffer != nullptr) {
+        buffer->thread_name = name;
+    }
+}
+
+void SpanTracer::record(const char *name, const int64_t start_ns, const int64_t end_ns) {
+    SpanBuffer *buffer = thread_buffer();
+    if (buffer == nullptr) {
+        return;
+    }
+
+    // Single writer, readers use only the spans below the published count
+    const uint64_t count = buffer->count.load(std::memory_order_relaxed);
+    buffer->spans[count % SPAN_BUFFER_SIZE] = {.name = name, .start_ns = start_ns, .duration_ns = end_ns - start_ns};
+    buffer->count.store(count + 1, std::memory_order_release);
+}
+
+void SpanTracer::request_write() {
+    m_write_requested.store(true, std::memory_order_relaxed);
+}
+
+SpanBuffer *SpanTracer::thread_buffer() {
+    if (t_buffer != nullptr || t_dropped) {
+        return t_buffer;
+    }
+
+    const size_t index = m_thread_count.fetch_add(1, std::memory_order_relaxed);
+    if (index >= SPAN_MAX_THREADS) {
+        t_dropped = true;
+        m_dropped_threads.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    // Allocated once per thread on its first span, kept until exit for the writer
+    auto *buffer = new SpanBuffer{};
+    buffer->tid = (uint32_t) index + 1;
+    m_threads[index].store(buffer, std::memory_order_release);
+    t_buffer = buffer;
+    return buffer;
+}
+
+bool SpanTracer::write(FILE *file) {
+    (void) fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    bool first = true;
+
+    for (auto &thread : m_threads) {
+        const SpanBuffer *buffer = thread.load(std::memory_order_acquire);
+        if (buffer == nullptr) {
+            continue;
+        }
+
+        const char *thread_name = buffer->thread_name.load(std::memory_order_relaxed);
+        if (thread_name != nullptr) {
+            (void) fprintf(file,
+                           "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+                           first ? "" : ",\n",
+                           buffer->tid,
+                           thread_name);
+            first = false;
+        }
+
+        // Skip the oldest quarter of a full ring, the owner may be overwriting it
+        const uint64_t count = buffer->count.load(std::memory_order_acquire);
+        const uint64_t begin = count > SPAN_BUFFER_SIZE ? count - (SPAN_BUFFER_SIZE * 3 / 4) : 0;
+        for (uint64_t j = begin; j < count; j++) {
+            const Span &span = buffer->spans[j % SPAN_BUFFER_SIZE];
+            (void) fprintf(file,
+                           "%s{\"name\":\"%s\",\"cat\":\"t6\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,"
+                           "\"ts\":%.3f,\"dur\":%.3f}",
+                           first ? "" : ",\n",
+                           span.name,
+                           buffer->tid,
+                           (double) span.start_ns / 1000.0,
+                           (double) span.duration_ns / 1000.0);
+            first = false;
+        }
+    }
+
+    (void) fprintf(file, "\n]}\n");
+    return ferror(file) == 0;
+}
+
+bool SpanTracer::write_file() {
+    FILE *file = fopen(m_path, "w");
+    if (file == nullptr) {
+        log_error("failed to open span trace file \"%s\"", m_path);
+        return false;
+    }
+
+    const bool written = write(file);
+    (void) fclose(file);
+    if (!written) {
+        log_error("failed to write span trace file \"%s\"", m_path);
+    }
+    return written;
+}
+
+void SpanTracer::writer_loop() {
+    while (m_running) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(SPAN_WRITE_POLL_MS));
+        if (m_write_requested.exchange(false, std::memory_order_relaxed) && write_file()) {
+            log_info("span trace written to \"%s\"", m_path);
+        }
+    }
+}
@@ -0,0 +1,151 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef SPAN_TRACER_HPP
+#define SPAN_TRACER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+
+// Spans kept per thread, older spans are overwritten
+#define SPAN_BUFFER_SIZE 65536
+#define SPAN_MAX_THREADS 8
+
+#define SPAN_CONCAT_(a, b) a##b
+#define SPAN_CONCAT(a, b) SPAN_CONCAT_(a, b)
+// Time the rest of the enclosing scope as a span, name must be a string literal
+#define TRACE_SCOPE(name) const SpanScope SPAN_CONCAT(span_scope_, __LINE__)(name)
+
+struct Span {
+    const char *name;
+    int64_t start_ns;
+    int64_t duration_ns;
+};
+
+// Spans of a single thread, written only by the owning thread
+struct SpanBuffer {
+    uint32_t tid;
+    std::atomic<const char *> thread_name;
+    std::atomic<uint64_t> count;
+    Span spans[SPAN_BUFFER_SIZE];
+};
+
+/**
+ * Records spans of the analyser and GUI threads for a Chrome trace
+ *
+ * Every thread records into its own ring buffer without locks. The spans
+ * are written as Chrome trace event JSON, viewable in Perfetto or
+ * chrome://tracing, when tracing stops and, where available, on SIGUSR2.
+ */
+class SpanTracer {
+public:
+    SpanTracer() = delete;
+    ~SpanTracer() = delete;
+
+    SpanTracer(const SpanTracer &) = delete;
+    SpanTracer(SpanTracer &&) = delete;
+    SpanTracer &operator=(const SpanTracer &) = delete;
+    SpanTracer &operator=(SpanTracer &&) = delete;
+
+    /**
+     * Start recording spans
+     *
+     * @param path JSON trace file, written on stop and on request
+     * @return true on success
+     */
+    static bool start(const char *path);
+    /**
+     * Write the trace file and stop recording
+     */
+    static void stop();
+    static bool enabled() {
+        return m_running.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Name the calling thread in the trace
+     *
+     * @param name thread name, must outlive the tracer
+     */
+    static void set_thread_name(const char *name);
+    /**
+     * Record a span of the calling thread
+     *
+     * @param name span name, must outlive the tracer
+     * @param start_ns span start
+     * @param end_ns span end
+     */
+    static void record(const char *name, const int64_t start_ns, const int64_t end_ns);
+    /**
+     * Write the trace file from the writer thread, async-signal-safe
+     */
+    static void request_write();
+    /**
+     * Write recorded spans as Chrome trace event JSON
+     *
+     * @param file output file
+     * @return true on success
+     */
+    static bool write(FILE *file);
+
+    static int64_t now_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+private:
+    static std::atomic<bool> m_running;
+    static std::atomic<bool> m_write_requested;
+    static std::atomic<size_t> m_thread_count;
+    static std::atomic<uint32_t> m_dropped_threads;
+    static std::atomic<SpanBuffer *> m_threads[SPAN_MAX_THREADS];
+    static thread_local SpanBuffer *t_buffer;
+    // Thread started after SPAN_MAX_THREADS others
+    static thread_local bool t_dropped;
+    static const char *m_path;
+    static std::thread m_writer;
+
+    static SpanBuffer *thread_buffer();
+    static bool write_file();
+    static void writer_loop();
+};
+
+class SpanScope {
+public:
+    explicit SpanScope(const char *name) : m_name(name), m_start(SpanTracer::enabled() ? SpanTracer::now_ns() : 0) {}
+    ~SpanScope() {
+        if (m_start != 0 && SpanTracer::enabled()) {
+            SpanTracer::record(m_name, m_start, SpanTracer::now_ns());
+        }
+    }
+
+    SpanScope(const SpanScope &) = delete;
+    SpanScope(SpanScope &&) = delete;
+    SpanScope &operator=(const SpanScope &) = delete;
+    SpanScope &operator=(SpanScope &&) = delete;
+
+private:
+    const char *m_name;
+    int64_t m_start;
+};
+
+#endif
@@ -0,0 +1,102 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef SPSC_QUEUE_HPP
+#define SPSC_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+
+/**
+ * Lock-free single producer single consumer queue
+ *
+ * All memory is allocated in the constructor. Capacity is rounded up to a power of two.
+ */
+template<typename T>
+class SpscQueue {
+public:
+    explicit SpscQueue(const size_t capacity) : m_capacity(round_up(capacity)), m_queue(new T[m_capacity]) {}
+
+    ~SpscQueue() {
+        delete[] m_queue;
+    }
+
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue(SpscQueue &&) = delete;
+    SpscQueue &operator=(const SpscQueue &) = delete;
+    SpscQueue &operator=(SpscQueue &&) = delete;
+
+    /**
+     * Push data to the queue (producer)
+     *
+     * @param data data to push
+     * @return false if the queue is full
+     */
+    bool push(const T &data) {
+        const size_t write = m_write.load(std::memory_order_relaxed);
+        if (write - m_read.load(std::memory_order_acquire) == m_capacity) {
+            return false;
+        }
+
+        m_queue[write & (m_capacity - 1)] = data;
+        m_write.store(write + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Pop data from the queue (consumer)
+     *
+     * @param data popped data
+     * @return false if the queue is empty
+     */
+    bool pop(T &data) {
+        const size_t read = m_read.load(std::memory_order_relaxed);
+        if (read == m_write.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        data = m_queue[read & (m_capacity - 1)];
+        m_read.store(read + 1, std::memory_order_release);
+        return true;
+    }
+
+    [[nodiscard]] bool empty() const {
+        return m_read.load(std::memory_order_acquire) == m_write.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] size_t capacity() const {
+        return m_capacity;
+    }
+
+private:
+    const size_t m_capacity;
+    T *m_queue;
+
+    // Producer and consumer indexes on separate cache lines
+    alignas(64) std::atomic<size_t> m_write = 0;
+    alignas(64) std::atomic<size_t> m_read = 0;
+
+    static size_t round_up(const size_t capacity) {
+        size_t size = 1;
+        while (size < capacity) {
+            size <<= 1U;
+        }
+        return size;
+    }
+};
+
+#endif
@@ -0,0 +1,157 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "tick_profiler.hpp"
+
+#include <csignal>
+
+#include "logging.h"
+
+namespace {
+constexpr const char *STAGE_NAMES[] = {
+    "sync", "read", "flip", "start frames", "connection", "strings", "distance", "status", "publish", "listener"};
+
+#ifdef SIGUSR1
+void summary_signal(int /*signal*/) {
+    TickProfiler::request_summary();
+}
+#endif
+
+double to_us(const uint64_t ns) {
+    return (double) ns / 1000.0;
+}
+} // namespace
+
+static_assert((size_t) TickStage::COUNT <= PERF_MAX_STAGES);
+
+bool TickProfiler::m_enabled = false;
+std::atomic<bool> TickProfiler::m_summary_requested = false;
+int64_t TickProfiler::m_deadline_ns = 0;
+int64_t TickProfiler::m_tick_start = 0;
+int64_t TickProfiler::m_lap_start = 0;
+uint32_t TickProfiler::m_touched = 0;
+int64_t TickProfiler::m_stage_ns[(size_t) TickStage::COUNT] = {};
+LatencyHistogram TickProfiler::m_stages[(size_t) TickStage::COUNT] = {};
+LatencyHistogram TickProfiler::m_ticks = {};
+std::atomic<uint64_t> TickProfiler::m_deadline_misses = 0;
+std::atomic<uint32_t> TickProfiler::m_miss_stages[(size_t) TickStage::COUNT] = {};
+
+void TickProfiler::enable(const int64_t deadline_ns) {
+    m_deadline_ns = deadline_ns;
+    m_enabled = true;
+
+#ifdef SIGUSR1
+    (void) signal(SIGUSR1, &summary_signal);
+    log_info("profiling analyser ticks, send SIGUSR1 for a summary");
+#else
+    log_info("profiling analyser ticks");
+#endif
+}
+
+void TickProfiler::end_tick() {
+    if (!m_enabled) {
+        return;
+    }
+
+    const int64_t tick_ns = now_ns() - m_tick_start;
+    latency_histogram_record(&m_ticks, (uint64_t) tick_ns);
+
+    // COUNT until the first touched stage
+    size_t longest = (size_t) TickStage::COUNT;
+    for (size_t i = 0; i < (size_t) TickStage::COUNT; i++) {
+        if ((m_touched & (1U << i)) == 0) {
+            continue;
+        }
+        latency_histogram_record(&m_stages[i], (uint64_t) m_stage_ns[i]);
+        if (longest == (size_t) TickStage::COUNT || m_stage_ns[i] > m_stage_ns[longest]) {
+            longest = i;
+        }
+    }
+
+    if (tick_ns > m_deadline_ns) {
+        m_deadline_misses.fetch_add(1, std::memory_order_relaxed);
+        // A tick without marks is counted but blames no stage
+        if (longest < (size_t) TickStage::COUNT) {
+            m_miss_stages[longest].fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    if (m_summary_requested.exchange(false, std::memory_order_relaxed)) {
+        log_summary();
+    }
+}
+
+void TickProfiler::log_summary() {
+    const uint64_t ticks = latency_histogram_count(&m_ticks);
+    if (ticks == 0) {
+        log_info("tick profile: no ticks");
+        return;
+    }
+
+    log_info("tick profile: %-12s %10s %10s %10s %10s", "stage", "samples", "p50 us", "p99 us", "max us");
+    for (size_t i = 0; i < (size_t) TickStage::COUNT; i++) {
+        const LatencyHistogram &stage = m_stages[i];
+        log_info("tick profile: %-12s %10llu %10.1f %10.1f %10.1f",
+                 STAGE_NAMES[i],
+                 (unsigned long long) latency_histogram_count(&stage),
+                 to_us(latency_histogram_percentile(&stage, 50)),
+                 to_us(latency_histogram_percentile(&stage, 99)),
+                 to_us(latency_histogram_max(&stage)));
+    }
+    log_info("tick profile: %-12s %10llu %10.1f %10.1f %10.1f",
+             "tick",
+             (unsigned long long) ticks,
+             to_us(latency_histogram_percentile(&m_ticks, 50)),
+             to_us(latency_histogram_percentile(&m_ticks, 99)),
+             to_us(latency_histogram_max(&m_ticks)));
+
+    const uint64_t misses = m_deadline_misses.load(std::memory_order_relaxed);
+    log_info("tick profile: %llu of %llu ticks over the %.1f us deadline",
+             (unsigned long long) misses,
+             (unsigned long long) ticks,
+             to_us((uint64_t) m_deadline_ns));
+    for (size_t i = 0; i < (size_t) TickStage::COUNT; i++) {
+        const uint32_t stage_misses = m_miss_stages[i].load(std::memory_order_relaxed);
+        if (stage_misses > 0) {
+            log_info("tick profile: %s was the longest stage of %u missed ticks", STAGE_NAMES[i], stage_misses);
+        }
+    }
+
+    if (PerfCounters::attached()) {
+        PerfCounters::log_summary(STAGE_NAMES, (size_t) TickStage::COUNT);
+    }
+}
+
+void TickProfiler::request_summary() {
+    m_summary_requested.store(true, std::memory_order_relaxed);
+}
+
+const char *TickProfiler::stage_name(const TickStage stage) {
+    return STAGE_NAMES[(size_t) stage];
+}
+
+const LatencyHistogram &TickProfiler::histogram(const TickStage stage) {
+    return m_stages[(size_t) stage];
+}
+
+uint64_t TickProfiler::deadline_misses() {
+    return m_deadline_misses.load(std::memory_order_relaxed);
+}
+
+uint32_t TickProfiler::stage_misses(const TickStage stage) {
+    return m_miss_stages[(size_t) stage].load(std::memory_order_relaxed);
+}
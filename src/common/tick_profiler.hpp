@@ -0,0 +1,154 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef TICK_PROFILER_HPP
+#define TICK_PROFILER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+
+#include "latency_histogram.h"
+#include "perf_counters.hpp"
+
+// Stages of an analyser tick, in tick order
+enum class TickStage : uint8_t {
+    SYNC, // Game frame number and sync check
+    READ, // Game state read
+    FLIP, // Player side flip
+    START_FRAMES,
+    CONNECTION,
+    STRINGS,
+    DISTANCE,
+    STATUS,
+    PUBLISH, // Shadow, export, event socket, logging and trace
+    LISTENER,
+    COUNT
+};
+
+/**
+ * Per-stage latency histograms of the analyser ticks
+ *
+ * Stages are timed as laps, each mark closes the stage which ran since the
+ * previous mark. Times of a stage marked several times in a tick are summed.
+ * The summary is logged on demand, on SIGUSR1 where available and at exit.
+ * Event counters of the attached thread are summed per stage on the same marks.
+ */
+class TickProfiler {
+public:
+    TickProfiler() = delete;
+    ~TickProfiler() = delete;
+
+    TickProfiler(const TickProfiler &) = delete;
+    TickProfiler(TickProfiler &&) = delete;
+    TickProfiler &operator=(const TickProfiler &) = delete;
+    TickProfiler &operator=(TickProfiler &&) = delete;
+
+    /**
+     * Start profiling ticks, call before the analyser starts
+     *
+     * @param deadline_ns tick length, longer ticks are deadline misses
+     */
+    static void enable(const int64_t deadline_ns);
+    static bool enabled() {
+        return m_enabled;
+    }
+
+    /**
+     * Start a tick (analyser thread only)
+     */
+    static void begin_tick() {
+        if (!m_enabled) {
+            return;
+        }
+        m_tick_start = now_ns();
+        m_lap_start = m_tick_start;
+        m_touched = 0;
+        if (PerfCounters::attached()) {
+            PerfCounters::begin();
+        }
+    }
+    /**
+     * Close a stage started by the previous mark (analyser thread only)
+     *
+     * @param stage stage which ran since the previous mark
+     */
+    static void mark(const TickStage stage) {
+        if (!m_enabled) {
+            return;
+        }
+        const int64_t now = now_ns();
+        const auto index = (size_t) stage;
+        m_stage_ns[index] = ((m_touched & (1U << index)) != 0 ? m_stage_ns[index] : 0) + (now - m_lap_start);
+        m_touched |= 1U << index;
+        m_lap_start = now;
+        if (PerfCounters::attached()) {
+            PerfCounters::lap(index);
+        }
+    }
+    /**
+     * Record the tick's stages (analyser thread only)
+     */
+    static void end_tick();
+
+    /**
+     * Log stage percentiles and deadline misses, safe from any thread
+     */
+    static void log_summary();
+    /**
+     * Log the summary at the end of the next tick, async-signal-safe
+     */
+    static void request_summary();
+
+    static const char *stage_name(const TickStage stage);
+    static const LatencyHistogram &histogram(const TickStage stage);
+    static uint64_t deadline_misses();
+    /**
+     * @param stage stage
+     * @return missed ticks in which the stage was the longest
+     */
+    static uint32_t stage_misses(const TickStage stage);
+
+    static int64_t now_ns() {
+#ifdef CLOCK_MONOTONIC_RAW
+        timespec time{};
+        (void) clock_gettime(CLOCK_MONOTONIC_RAW, &time);
+        return ((int64_t) time.tv_sec * 1000000000) + time.tv_nsec;
+#else
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+#endif
+    }
+
+private:
+    static bool m_enabled;
+    static std::atomic<bool> m_summary_requested;
+    static int64_t m_deadline_ns;
+    static int64_t m_tick_start;
+    static int64_t m_lap_start;
+    static uint32_t m_touched;
+    static int64_t m_stage_ns[(size_t) TickStage::COUNT];
+    static LatencyHistogram m_stages[(size_t) TickStage::COUNT];
+    static LatencyHistogram m_ticks;
+    static std::atomic<uint64_t> m_deadline_misses;
+    // Longest stage of the ticks which missed the deadline
+    static std::atomic<uint32_t> m_miss_stages[(size_t) TickStage::COUNT];
+};
+
+#endif
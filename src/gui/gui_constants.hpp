@@ -34,6 +34,11 @@
 #define NO_STATUS "Status ---"
 #define NO_DISTANCE "Distance ---"
 
+// Timeline on the right side of the overlay
+#define TIMELINE_X 600
+#define TIMELINE_WIDTH (MAX_WIDTH - TIMELINE_X - TEXT_MARGIN)
+#define TIMELINE_HEIGHT (MAX_HEIGTH - (2 * TEXT_MARGIN))
+
 #define BORDER_MARGIN_X 25
 #define BORDER_MARGIN_Y 15
 
@@ -15,41 +15,30 @@
   along with this program.    If not, see <https://www.gnu.org/licenses/>.
 */
 
-// Based on text rendering example from: https://learnopengl.com
-
 #include "arg_parser.hpp"
-#include <map>
-#include <string>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <thread>
 
 #include <glad/gl.h> // NOLINT
 
-#include <ft2build.h> // NOLINT
-#include <sys/types.h>
-#include FT_FREETYPE_H
-
 #include <GLFW/glfw3.h>
-#include <glm/glm.hpp>
-#include <glm/gtc/matrix_transform.hpp>
-#include <glm/gtc/type_ptr.hpp>
-#include <utility>
 
 #include "logging.h"
 
 #include "frame_data_analyser.hpp"
+#include "runtime_features.hpp"
+#include "span_tracer.hpp"
 #include "gui_constants.hpp"
 #include "platform_gui.hpp"
 #include "platform_threading.hpp"
-#include "shaders.hpp"
+#include "renderer.hpp"
 #include "version.hpp"
 
-#include "generated-src/fonts.h"
-
 namespace {
 
 // Constants
-#define TEXT_COLOR_GREEN glm::vec3(0.5, 1.0F, 0.2F)
-#define TEXT_COLOR_RED glm::vec3(1.0, 0.2F, 0.2F)
 #define RESET_UI_MILLIS 2500
 
 // Global variables
@@ -58,96 +47,72 @@ struct FrameDataPoint g_data_point = {};
 float g_distance = 0;
 PlayerState g_status = {};
 bool g_game_hooked = false;
-
-struct FontChar {
-    unsigned int texture_id; // ID handle of the glyph texture
-    glm::ivec2 size; // Size of glyph
-    glm::ivec2 bearing; // Offset from baseline to left/top of glyph
-    unsigned int advance; // Horizontal offset to advance to next glyph
-};
-
-std::map<GLchar, FontChar> font_chars;
-unsigned int g_vao, g_vbo;
-unsigned int g_shader_program;
-
-class Listener : public EventListener {
-public:
-    void frame_data(const FrameDataPoint frame_data) override;
-    void distance(const float distance) override;
-    void status(const PlayerState state) override;
-    void game_hooked() override;
-};
-
-void Listener::frame_data(const FrameDataPoint frame_data) {
-    g_last_update = std::chrono::steady_clock::now();
-    g_data_point = frame_data;
-    log_info("startup frames: %d, frame advantage: %d, KD: %d",
-             frame_data.startup_frames,
-             frame_data.frame_advantage,
-             frame_data.knock_down);
-}
-
-void Listener::distance(const float distance) {
-    g_distance = distance;
+// Set when the overlay content has changed and needs to be drawn again
+std::atomic<bool> g_redraw = true;
+
+/**
+ * Wake up the GUI loop to draw the overlay again, callable from any thread
+ */
+void request_redraw() {
+    g_redraw = true;
+    glfwPostEmptyEvent();
 }
 
-void Listener::status(const PlayerState state) {
-    g_status = state;
+void window_refresh_callback(GLFWwindow * /*window*/) {
+    g_redraw = true;
 }
 
-void Listener::game_hooked() {
-    g_game_hooked = true;
-    platform_find_game_window();
-}
-
-Listener g_listener;
-
-void render_text(unsigned int shader, std::string text, float x, float y, float scale, glm::vec3 color) { // NOLINT
-    glUseProgram(shader);
-    glUniform3f(glGetUniformLocation(shader, "textColor"), color.x, color.y, color.z);
-    glActiveTexture(GL_TEXTURE0);
-    glBindVertexArray(g_vao);
-
-    // Iterate through all characters
-    std::string::const_iterator c;
-    for (c = text.begin(); c != text.end(); c++) {
-        const FontChar ch = font_chars[*c];
-
-        const float xpos = x + ((float) ch.bearing.x * scale);
-        const float ypos = y - ((float) (ch.size.y - ch.bearing.y) * scale);
-
-        const float w = (float) ch.size.x * scale;
-        const float h = (float) ch.size.y * scale;
+class Listener : public EventListener {
+public:
+    void tick(const TickEvents &events) override;
 
-        // Update VBO for each character
-        float vertices[6][4] = {{xpos, ypos + h, 0.0F, 0.0F},
-                                {xpos, ypos, 0.0F, 1.0F},
-                                {xpos + w, ypos, 1.0F, 1.0F},
+private:
+    // Analyser tick of the last distance sample
+    uint32_t m_distance_tick = 0;
+};
 
-                                {xpos, ypos + h, 0.0F, 0.0F},
-                                {xpos + w, ypos, 1.0F, 1.0F},
-                                {xpos + w, ypos + h, 1.0F, 0.0F}};
+void Listener::tick(const TickEvents &events) {
+    if ((events.changed & TICK_FRAME_DATA) != 0) {
+        const FrameDataPoint &frame_data = events.frame_data;
+        g_last_update = std::chrono::steady_clock::now();
+        g_data_point = frame_data;
+        log_info("startup frames: %d, frame advantage: %d, KD: %d",
+                 frame_data.startup_frames,
+                 frame_data.frame_advantage,
+                 frame_data.knock_down);
+        renderer_push_timeline_samples(TIMELINE_ADVANTAGE, (float) frame_data.frame_advantage, 1);
+    }
 
-        // Render glyph to quad
-        glBindTexture(GL_TEXTURE_2D, ch.texture_id);
+    // One distance sample per analyser tick, ticks without events repeat the last distance
+    const float previous_distance = g_distance;
+    if ((events.changed & TICK_DISTANCE) != 0) {
+        g_distance = events.distance;
+    }
+    const uint32_t ticks = events.tick >= m_distance_tick ? events.tick - m_distance_tick : 1;
+    if (ticks > 1) {
+        renderer_push_timeline_samples(TIMELINE_DISTANCE, previous_distance, ticks - 1);
+    }
+    if (ticks > 0 || (events.changed & TICK_DISTANCE) != 0) {
+        renderer_push_timeline_samples(TIMELINE_DISTANCE, g_distance, 1);
+    }
+    m_distance_tick = events.tick;
 
-        // Update VBO
-        glBindBuffer(GL_ARRAY_BUFFER, g_vbo);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    if ((events.changed & TICK_STATUS) != 0) {
+        g_status = events.status;
+    }
 
-        // Render quad
-        glDrawArrays(GL_TRIANGLES, 0, 6);
-        x += (float) (ch.advance >> (unsigned int) 6) * scale; // Bitshift by 6 to get value in pixels (2^6 = 64)
+    if ((events.changed & TICK_HOOK) != 0) {
+        g_game_hooked = events.hooked;
+        if (events.hooked) {
+            platform_find_game_window();
+        }
     }
-    glBindVertexArray(0);
-    glBindTexture(GL_TEXTURE_2D, 0);
-}
 
-void render_line(std::string text, int line, glm::vec3 color) {
-    render_text(g_shader_program, std::move(text), 0, (float) ((FONT_SIZE * line) + TEXT_MARGIN), 1, color);
+    request_redraw();
 }
 
+Listener g_listener;
+
 GLFWwindow *create_window() {
     GLFWwindow *window = nullptr;
     if (glfwInit() == 0) {
@@ -179,137 +144,13 @@ GLFWwindow *create_window() {
     return window;
 }
 
-bool setup_shaders() {
-    g_shader_program = glCreateProgram();
-
-    const unsigned int vs = glCreateShader(GL_VERTEX_SHADER);
-    if (vs == 0) {
-        log_error("failed to create vertex shader");
-        return false;
-    }
-    glShaderSource(vs, 1, &VERTEX_SHADER_SOURCE, nullptr);
-    glCompileShader(vs);
-
-    const unsigned int fs = glCreateShader(GL_FRAGMENT_SHADER);
-    if (fs == 0) {
-        log_error("failed to create fragment shader");
-        return false;
-    }
-    glShaderSource(fs, 1, &FRAGMENT_SHADER_SOURCE, nullptr);
-    glCompileShader(fs);
-
-    glAttachShader(g_shader_program, vs);
-    glAttachShader(g_shader_program, fs);
-    glLinkProgram(g_shader_program);
-
-    glDeleteShader(vs);
-    glDeleteShader(fs);
-
-    glm::mat4 projection = glm::ortho(0.0F, (float) MAX_WIDTH, 0.0F, (float) MAX_HEIGTH);
-    glUseProgram(g_shader_program);
-    glUniformMatrix4fv(glGetUniformLocation(g_shader_program, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
-
-
-    // Configure VAO/VBO for texture quads
-    glGenVertexArrays(1, &g_vao);
-    glGenBuffers(1, &g_vbo);
-    glBindVertexArray(g_vao);
-    glBindBuffer(GL_ARRAY_BUFFER, g_vbo);
-
-    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 4, nullptr, GL_DYNAMIC_DRAW);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), nullptr);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
-
-    return true;
-}
-
-void set_blending() {
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-}
-
-bool load_font() {
-    FT_Library ft = nullptr;
-    if (FT_Init_FreeType(&ft) != 0) {
-        return false;
-    }
-
-    FT_Face face = nullptr;
-    if (FT_New_Memory_Face(ft, fonts_DejaVuSansMono_ttf, fonts_DejaVuSansMono_ttf_len, 0, &face) != 0) {
-        log_error("font not found");
-        return false;
-    }
-
-    // Glyph size
-    FT_Set_Pixel_Sizes(face, 0, FONT_SIZE);
-
-    // Disable byte-alignment restriction, as FreeType glyphs aren't aligned to 4-bytes
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-
-    // Load first 128 characters of ASCII set
-    for (unsigned char c = 0; c < 128; c++) {
-        // Load character glyph
-        if (FT_Load_Char(face, c, FT_LOAD_RENDER) != 0) { // NOLINT
-            continue;
-        }
-
-        // Generate texture
-        unsigned int texture = 0;
-        glGenTextures(1, &texture);
-        glBindTexture(GL_TEXTURE_2D, texture);
-        glTexImage2D(GL_TEXTURE_2D,
-                     0,
-                     GL_RED, // Use GL_RED for single-channel grayscale image
-                     (int) face->glyph->bitmap.width,
-                     (int) face->glyph->bitmap.rows,
-                     0,
-                     GL_RED,
-                     GL_UNSIGNED_BYTE,
-                     face->glyph->bitmap.buffer);
-
-        // Texture parameters
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-        const FontChar character = {.texture_id = texture,
-                                    .size = glm::ivec2(face->glyph->bitmap.width, face->glyph->bitmap.rows),
-                                    .bearing = glm::ivec2(face->glyph->bitmap_left, face->glyph->bitmap_top),
-                                    .advance = static_cast<unsigned int>(face->glyph->advance.x)};
-
-        font_chars.insert(std::pair<char, FontChar>(c, character));
-    }
-    glBindTexture(GL_TEXTURE_2D, 0);
-
-    // Free FT resources
-    FT_Done_Face(face);
-    FT_Done_FreeType(ft);
-
-    return true;
-}
-
 bool setup_graphics() {
     if (gladLoadGL(glfwGetProcAddress) == 0) {
         log_error("failed to load glad GL");
         return false;
     }
 
-    if (!setup_shaders()) {
-        log_error("setting up shaders has failed");
-        return false;
-    }
-
-    set_blending();
-
-    if (!load_font()) {
-        log_error("loading font has failed");
-        return false;
-    }
-
-    return true;
+    return renderer_init();
 }
 
 GLFWwindow *setup_gui() {
@@ -339,6 +180,7 @@ GLFWwindow *setup_gui() {
 void gui_state_no_game() {
     platform_update_ui_position(0, 0, MAX_HEIGTH, false);
     g_game_hooked = false;
+    request_redraw();
 }
 
 void analyser_loop() {
@@ -358,86 +200,47 @@ void analyser_loop() {
     }
 }
 
-void draw_frame_data() {
-    char buffer[50];
-
-    (void) sprintf(buffer, DISTANCE, g_distance);
-    render_line(buffer, 0, TEXT_COLOR_GREEN);
-
-    (void) sprintf(buffer, STATUS, FrameDataAnalyser::player_status(g_status));
-    render_line(buffer, 1, TEXT_COLOR_GREEN);
-
-    if (g_data_point.knock_down) {
-        render_line(FRAME_ADVANTAGE_KD, 2, TEXT_COLOR_GREEN);
-    } else {
-        (void) sprintf(buffer, FRAME_ADVANTAGE, g_data_point.frame_advantage);
-        if (g_data_point.frame_advantage < 0) {
-            render_line(buffer, 2, TEXT_COLOR_RED);
-        } else {
-            render_line(buffer, 2, TEXT_COLOR_GREEN);
-        }
-    }
-
-    (void) sprintf(buffer, STARTUP_FRAMES, g_data_point.startup_frames);
-    render_line(buffer, 3, TEXT_COLOR_GREEN);
-}
-
-void draw_no_frame_data() {
-    char buffer[50];
-
-    (void) sprintf(buffer, DISTANCE, g_distance);
-    render_line(buffer, 0, TEXT_COLOR_GREEN);
-
-    (void) sprintf(buffer, STATUS, FrameDataAnalyser::player_status(g_status));
-    render_line(buffer, 1, TEXT_COLOR_GREEN);
-
-    render_line(NO_FRAME_ADVANTAGE, 2, TEXT_COLOR_GREEN);
-    render_line(NO_STARTUP_FRAMES, 3, TEXT_COLOR_GREEN);
-}
-
-void draw_game_state() {
+long long millis_since_update() {
     auto now = std::chrono::steady_clock::now();
-    auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(now - g_last_update).count();
-    if (millis > RESET_UI_MILLIS) {
-        draw_no_frame_data();
-    } else {
-        draw_frame_data();
-    }
-}
-
-void draw_no_game() {
-    render_line(NO_DISTANCE, 0, TEXT_COLOR_GREEN);
-    render_line(NO_STATUS, 1, TEXT_COLOR_GREEN);
-    render_line(NO_FRAME_ADVANTAGE, 2, TEXT_COLOR_GREEN);
-    render_line(NO_STARTUP_FRAMES_NO_GAME, 3, TEXT_COLOR_GREEN);
+    return std::chrono::duration_cast<std::chrono::milliseconds>(now - g_last_update).count();
 }
 
 void gui_loop(GLFWwindow *window) {
+    glfwSetWindowRefreshCallback(window, &window_refresh_callback);
+    bool frame_data_shown = false;
+
     /* Loop until the user closes the window */
     while (glfwWindowShouldClose(window) == 0) {
-        // Tick platform functions
-        platform_update();
-
-        /* Render here */
-        glClear(GL_COLOR_BUFFER_BIT);
+        // Draw only when something has changed or frame data has expired
+        if (g_redraw.exchange(false) || (frame_data_shown && millis_since_update() > RESET_UI_MILLIS)) {
+            const OverlayState state = {.game_hooked = g_game_hooked,
+                                        .frame_data_valid = millis_since_update() <= RESET_UI_MILLIS,
+                                        .data_point = g_data_point,
+                                        .distance = g_distance,
+                                        .status = g_status};
+            {
+                TRACE_SCOPE("render");
+                renderer_draw(state);
+            }
+            frame_data_shown = state.game_hooked && state.frame_data_valid;
+
+            /* Swap front and back buffers */
+            TRACE_SCOPE("swap buffers");
+            glfwSwapBuffers(window);
+        }
 
-        if (g_game_hooked) {
-            draw_game_state();
+        /* Sleep until an event, a redraw request or the frame data timeout */
+        if (frame_data_shown) {
+            const long long remaining = RESET_UI_MILLIS - millis_since_update() + 1;
+            glfwWaitEventsTimeout((double) std::max(remaining, 1LL) / 1000.0);
         } else {
-            draw_no_game();
+            glfwWaitEvents();
         }
-
-        /* Swap front and back buffers */
-        glfwSwapBuffers(window);
-
-        /* Poll for and process events */
-        glfwPollEvents();
     }
-
-    glfwTerminate();
 }
 
 void start_gui(GLFWwindow *window) {
+    SpanTracer::set_thread_name("gui");
     std::thread analyser_thread(&analyser_loop);
     set_realtime_prio(analyser_thread);
 
@@ -446,11 +249,9 @@ void start_gui(GLFWwindow *window) {
     // GUI has exited
     FrameDataAnalyser::stop();
     analyser_thread.join();
-}
-
-void apply_config(Configuration &config) {
-    log_set_level(config.log_level);
-    FrameDataAnalyser::set_logging(config.frame_data_logging);
+    platform_stop();
+    glfwTerminate();
+    RuntimeFeatures::stop();
 }
 
 } // namespace
@@ -465,12 +266,13 @@ int main(const int argc, const char **argv) {
         return 0;
     }
 
-    apply_config(config);
+    RuntimeFeatures::start(config);
 
     log_info("%s %s", PROGRAM_NAME, VERSION);
 
     GLFWwindow *window = setup_gui();
     if (window == nullptr) {
+        RuntimeFeatures::stop();
         return -1;
     }
 
@@ -20,8 +20,11 @@
 struct GLFWwindow;
 
 bool platform_make_overlay(GLFWwindow *window);
+/**
+ * Release platform resources, called before GLFW is terminated
+ */
+void platform_stop();
 void platform_update_ui_position(const int game_x, const int game_y, const int game_height, const bool margin);
 void platform_find_game_window();
-void platform_update();
 
 #endif
@@ -18,80 +18,110 @@
 
 #include "platform_gui.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
 #include <cstring>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
 
 #include <GLFW/glfw3.h>
 #define GLFW_EXPOSE_NATIVE_X11
 #include "GLFW/glfw3native.h"
 
-#include <X11/Xatom.h>
 #include <X11/Xlib.h>
+#include <xcb/xcb.h>
 
 #include "gui_constants.hpp"
 #include "logging.h"
 
+// Longest window class or name compared, in 32-bit units
+#define PROPERTY_LENGTH 64
+
 namespace {
+struct OverlayPosition {
+    bool pending;
+    int x;
+    int y;
+};
+
+// Replies of the property requests sent for a single window
+struct WindowQuery {
+    xcb_window_t window;
+    xcb_get_property_cookie_t class_cookie;
+    xcb_get_property_cookie_t name_cookie;
+};
+
 Window g_window;
-Window g_game_window;
 Display *g_display;
-Display *g_event_display;
-
-char *get_window_class(const Window window) {
-    const Atom prop = XInternAtom(g_display, "WM_CLASS", False);
-    Atom type = 0;
-    int form = 0;
-    unsigned long remain = 0;
-    unsigned long len = 0;
-    unsigned char *list = nullptr;
-
-    if (XGetWindowProperty(g_display, window, prop, 0, 1024, False, XA_STRING, &type, &form, &len, &remain, &list) !=
-        Success) {
-        log_error("failed to read window class");
-        return nullptr;
-    }
-
-    return (char *) list; // NOLINT
-}
-
-Window *get_windows(unsigned long *len) {
-    const Atom prop = XInternAtom(g_display, "_NET_CLIENT_LIST", False);
-    Atom type = 0;
-    int form = 0;
-    unsigned long remain = 0;
-    unsigned char *list = nullptr;
-
-    if (XGetWindowProperty(g_display,
-                           XDefaultRootWindow(g_display),
-                           prop,
-                           0,
-                           1024,
-                           False,
-                           XA_WINDOW,
-                           &type,
-                           &form,
-                           len,
-                           &remain,
-                           &list) != Success) {
-        log_error("failed to get window list");
-        return nullptr;
+
+// Owned by the event thread, GLFW's display is not thread-safe
+xcb_connection_t *g_connection;
+xcb_window_t g_root;
+xcb_atom_t g_client_list_atom;
+xcb_window_t g_game_window = XCB_NONE;
+// Last seen _NET_CLIENT_LIST, sorted
+std::vector<xcb_window_t> g_client_windows;
+
+std::thread g_event_thread;
+std::atomic<bool> g_event_thread_running = false;
+// Wakes up the event thread
+int g_wake_fd = -1;
+std::atomic<bool> g_find_requested = false;
+std::mutex g_position_mutex;
+OverlayPosition g_position = {};
+
+xcb_atom_t intern_atom(const char *name) {
+    const xcb_intern_atom_cookie_t cookie = xcb_intern_atom(g_connection, 0, strlen(name), name);
+    xcb_intern_atom_reply_t *reply = xcb_intern_atom_reply(g_connection, cookie, nullptr);
+    if (reply == nullptr) {
+        return XCB_ATOM_NONE;
+    }
+
+    const xcb_atom_t atom = reply->atom;
+    free(reply); // NOLINT
+    return atom;
+}
+
+/**
+ * Copy property value as a string
+ *
+ * @return false if the property is missing
+ */
+bool property_string(xcb_get_property_reply_t *reply, char *buffer, const size_t size) {
+    if (reply == nullptr) {
+        return false;
     }
-    return (Window *) list; // NOLINT
+
+    const size_t len = std::min((size_t) xcb_get_property_value_length(reply), size - 1);
+    memcpy(buffer, xcb_get_property_value(reply), len);
+    buffer[len] = '\0'; // NOLINT
+    free(reply); // NOLINT
+    return len > 0;
 }
-char *get_window_name(const Window window) {
-    const Atom prop = XInternAtom(g_display, "WM_NAME", False);
-    Atom type = 0;
-    int form = 0;
-    unsigned long remain = 0;
-    unsigned long len = 0;
-    unsigned char *list = nullptr;
 
-    if (XGetWindowProperty(g_display, window, prop, 0, 1024, False, XA_STRING, &type, &form, &len, &remain, &list) !=
-        Success) {
-        log_error("failed to read window name");
-        return nullptr;
+bool get_client_windows(std::vector<xcb_window_t> &windows) {
+    const xcb_get_property_cookie_t cookie =
+        xcb_get_property(g_connection, 0, g_root, g_client_list_atom, XCB_ATOM_WINDOW, 0, UINT32_MAX);
+    xcb_get_property_reply_t *reply = xcb_get_property_reply(g_connection, cookie, nullptr);
+    if (reply == nullptr) {
+        log_error("failed to get window list");
+        return false;
     }
 
-    return (char *) list; // NOLINT
+    const auto *list = (const xcb_window_t *) xcb_get_property_value(reply);
+    const size_t len = xcb_get_property_value_length(reply) / sizeof(xcb_window_t);
+    windows.assign(list, list + len); // NOLINT
+    std::sort(windows.begin(), windows.end());
+    free(reply); // NOLINT
+    return true;
 }
 
 bool window_match(const char *window_class, const char *window_name) {
@@ -105,6 +135,216 @@ bool window_match(const char *window_class, const char *window_name) {
 
     return true;
 }
+
+void wake_event_thread() {
+    const uint64_t value = 1;
+    if (write(g_wake_fd, &value, sizeof(value)) != sizeof(value)) {
+        log_error("failed to wake up platform event thread");
+    }
+}
+
+OverlayPosition overlay_position(const int game_x, const int game_y, const int game_height, const bool margin) {
+    if (margin) {
+        return {.pending = true,
+                .x = game_x + BORDER_MARGIN_X,
+                .y = game_y - BORDER_MARGIN_Y + game_height - MAX_HEIGTH};
+    }
+    return {.pending = true, .x = game_x, .y = game_y + game_height - MAX_HEIGTH};
+}
+
+void move_overlay(const OverlayPosition &position) {
+    const uint32_t values[] = {(uint32_t) position.x, (uint32_t) position.y, XCB_STACK_MODE_ABOVE};
+    xcb_configure_window(g_connection,
+                         g_window,
+                         XCB_CONFIG_WINDOW_X | XCB_CONFIG_WINDOW_Y | XCB_CONFIG_WINDOW_STACK_MODE,
+                         values);
+    xcb_map_window(g_connection, g_window);
+}
+
+void hook_game_window(const xcb_window_t window) {
+    g_game_window = window;
+
+    const uint32_t mask = XCB_EVENT_MASK_STRUCTURE_NOTIFY | XCB_EVENT_MASK_PROPERTY_CHANGE;
+    xcb_change_window_attributes(g_connection, window, XCB_CW_EVENT_MASK, &mask);
+
+    xcb_get_geometry_reply_t *geometry =
+        xcb_get_geometry_reply(g_connection, xcb_get_geometry(g_connection, window), nullptr);
+    if (geometry == nullptr) {
+        return;
+    }
+    move_overlay(overlay_position(geometry->x, geometry->y, geometry->height, true));
+    free(geometry); // NOLINT
+}
+
+/**
+ * Look for the game window, all property requests are sent before waiting for any reply
+ *
+ * @return true if found
+ */
+bool find_game_window(const xcb_window_t *windows, const size_t count) {
+    std::vector<WindowQuery> queries(count);
+    for (size_t i = 0; i < count; i++) {
+        queries[i] = {.window = windows[i], // NOLINT
+                      .class_cookie = xcb_get_property(
+                          g_connection, 0, windows[i], XCB_ATOM_WM_CLASS, XCB_ATOM_ANY, 0, PROPERTY_LENGTH), // NOLINT
+                      .name_cookie = xcb_get_property(
+                          g_connection, 0, windows[i], XCB_ATOM_WM_NAME, XCB_ATOM_ANY, 0, PROPERTY_LENGTH)}; // NOLINT
+    }
+
+    bool found = false;
+    for (const WindowQuery &query : queries) {
+        if (found) {
+            xcb_discard_reply(g_connection, query.class_cookie.sequence);
+            xcb_discard_reply(g_connection, query.name_cookie.sequence);
+            continue;
+        }
+
+        char window_class[PROPERTY_LENGTH * 4];
+        char window_name[PROPERTY_LENGTH * 4];
+        const bool has_class = property_string(xcb_get_property_reply(g_connection, query.class_cookie, nullptr),
+                                               window_class,
+                                               sizeof(window_class));
+        const bool has_name = property_string(
+            xcb_get_property_reply(g_connection, query.name_cookie, nullptr), window_name, sizeof(window_name));
+        if (!has_class) {
+            continue;
+        }
+
+        if (has_name && window_match(window_class, window_name)) {
+            log_info("found game window %s, %s", window_class, window_name);
+            hook_game_window(query.window);
+            found = true;
+        } else if (strcasestr(window_class, RPSC3_CLASS) != nullptr) {
+            // The emulator renames its window when the game starts
+            const uint32_t mask = XCB_EVENT_MASK_PROPERTY_CHANGE;
+            xcb_change_window_attributes(g_connection, query.window, XCB_CW_EVENT_MASK, &mask);
+        }
+    }
+
+    return found;
+}
+
+void rescan_windows() {
+    if (!get_client_windows(g_client_windows)) {
+        return;
+    }
+
+    if (!find_game_window(g_client_windows.data(), g_client_windows.size())) {
+        log_error("no game window found");
+    }
+}
+
+/**
+ * Check only windows which were added to the client list
+ */
+void handle_client_list_change() {
+    std::vector<xcb_window_t> windows;
+    if (!get_client_windows(windows)) {
+        return;
+    }
+
+    std::vector<xcb_window_t> added;
+    std::set_difference(
+        windows.begin(), windows.end(), g_client_windows.begin(), g_client_windows.end(), std::back_inserter(added));
+    g_client_windows.swap(windows);
+
+    if (g_game_window != XCB_NONE &&
+        !std::binary_search(g_client_windows.begin(), g_client_windows.end(), g_game_window)) {
+        log_info("game window closed");
+        g_game_window = XCB_NONE;
+    }
+
+    if (g_game_window == XCB_NONE && !added.empty()) {
+        (void) find_game_window(added.data(), added.size());
+    }
+}
+
+void handle_requests() {
+    if (g_find_requested.exchange(false)) {
+        rescan_windows();
+    }
+
+    OverlayPosition position = {};
+    {
+        const std::lock_guard<std::mutex> lock(g_position_mutex);
+        position = g_position;
+        g_position.pending = false;
+    }
+
+    if (position.pending) {
+        move_overlay(position);
+    }
+}
+
+void handle_x_events() {
+    xcb_generic_event_t *event = nullptr;
+    while ((event = xcb_poll_for_event(g_connection)) != nullptr) {
+        switch (event->response_type & ~0x80U) {
+        case XCB_CONFIGURE_NOTIFY: {
+            const auto *configure = (xcb_configure_notify_event_t *) event; // NOLINT
+            if (configure->window == g_game_window) {
+                move_overlay(overlay_position(configure->x, configure->y, configure->height, true));
+            }
+            break;
+        }
+        case XCB_PROPERTY_NOTIFY: {
+            const auto *property = (xcb_property_notify_event_t *) event; // NOLINT
+            if (property->window == g_root && property->atom == g_client_list_atom) {
+                handle_client_list_change();
+            } else if (property->atom == XCB_ATOM_WM_NAME && g_game_window == XCB_NONE) {
+                (void) find_game_window(&property->window, 1);
+            }
+            break;
+        }
+        default:
+            break;
+        }
+        free(event); // NOLINT
+    }
+    xcb_flush(g_connection);
+}
+
+/**
+ * Sleep until the game window changes or other threads post requests
+ */
+void event_loop() {
+    pollfd fds[2] = {{.fd = xcb_get_file_descriptor(g_connection), .events = POLLIN, .revents = 0},
+                     {.fd = g_wake_fd, .events = POLLIN, .revents = 0}};
+
+    while (g_event_thread_running) {
+        handle_requests();
+        // Also flushes the requests made above
+        handle_x_events();
+
+        if (poll(fds, 2, -1) < 0) {
+            continue;
+        }
+
+        if ((fds[1].revents & POLLIN) != 0) {
+            uint64_t value = 0;
+            (void) read(g_wake_fd, &value, sizeof(value));
+        }
+    }
+}
+
+bool connect_events() {
+    g_connection = xcb_connect(nullptr, nullptr);
+    if (xcb_connection_has_error(g_connection) != 0) {
+        log_error("failed to connect to X server");
+        xcb_disconnect(g_connection);
+        g_connection = nullptr;
+        return false;
+    }
+
+    g_root = xcb_setup_roots_iterator(xcb_get_setup(g_connection)).data->root;
+    g_client_list_atom = intern_atom("_NET_CLIENT_LIST");
+
+    // New and closed windows are seen through _NET_CLIENT_LIST changes
+    const uint32_t mask = XCB_EVENT_MASK_PROPERTY_CHANGE;
+    xcb_change_window_attributes(g_connection, g_root, XCB_CW_EVENT_MASK, &mask);
+    xcb_flush(g_connection);
+    return true;
+}
 } // namespace
 
 bool platform_make_overlay(GLFWwindow *window) {
@@ -114,13 +354,6 @@ bool platform_make_overlay(GLFWwindow *window) {
         return false;
     }
 
-    g_event_display = XOpenDisplay(nullptr);
-
-    if (g_event_display == nullptr) {
-        log_error("failed to get display X11 display");
-        return false;
-    }
-
     g_window = glfwGetX11Window(window);
     if (g_window == 0) {
         log_error("failed to get X11 window");
@@ -135,61 +368,48 @@ bool platform_make_overlay(GLFWwindow *window) {
     attrs.override_redirect = True;
     XChangeWindowAttributes(g_display, g_window, CWOverrideRedirect, &attrs);
     XMapWindow(g_display, g_window);
+    XFlush(g_display);
 
-    return true;
-}
-
-void platform_update_ui_position(const int game_x, const int game_y, const int game_height, const bool margin) {
-    int x = 0;
-    int y = 0;
-    if (margin) {
-        x = game_x + BORDER_MARGIN_X;
-        y = game_y - BORDER_MARGIN_Y + game_height - MAX_HEIGTH;
-    } else {
-        x = game_x;
-        y = game_y + game_height - MAX_HEIGTH;
+    if (!connect_events()) {
+        return false;
     }
 
-    XMoveWindow(g_display, g_window, x, y);
-    XMapRaised(g_display, g_window);
-}
+    g_wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (g_wake_fd < 0) {
+        log_error("failed to create platform event fd");
+        return false;
+    }
 
-void platform_find_game_window() {
-    unsigned long len = 0;
+    g_event_thread_running = true;
+    g_event_thread = std::thread(&event_loop);
 
-    const Window *windows = get_windows(&len);
+    return true;
+}
 
-    if (windows == nullptr) {
+void platform_stop() {
+    if (!g_event_thread_running) {
         return;
     }
 
-    for (unsigned long i = 0; i < len; i++) {
-        const char *window_class = get_window_class(windows[i]);
-        const char *window_name = get_window_name(windows[i]);
-        if (window_match(window_class, window_name)) {
-            log_info("found game window %s, %s", window_class, window_name);
-            g_game_window = windows[i];
+    g_event_thread_running = false;
+    wake_event_thread();
+    g_event_thread.join();
 
-            XSelectInput(g_event_display, g_game_window, StructureNotifyMask);
+    xcb_disconnect(g_connection);
+    g_connection = nullptr;
+    close(g_wake_fd);
+    g_wake_fd = -1;
+}
 
-            XWindowAttributes xwa;
-            XGetWindowAttributes(g_display, g_game_window, &xwa);
-            platform_update_ui_position(xwa.x, xwa.y, xwa.height, true);
-            return;
-        }
+void platform_update_ui_position(const int game_x, const int game_y, const int game_height, const bool margin) {
+    {
+        const std::lock_guard<std::mutex> lock(g_position_mutex);
+        g_position = overlay_position(game_x, game_y, game_height, margin);
     }
-
-    log_error("no game window found");
+    wake_event_thread();
 }
 
-void platform_update() {
-    while (XPending(g_event_display) > 0) {
-        XEvent e;
-        XNextEvent(g_event_display, &e);
-
-        if (e.type == ConfigureNotify && e.xconfigure.window == g_game_window) {
-            const XConfigureEvent xce = e.xconfigure;
-            platform_update_ui_position(xce.x, xce.y, xce.height, true);
-        }
-    }
+void platform_find_game_window() {
+    g_find_requested = true;
+    wake_event_thread();
 }
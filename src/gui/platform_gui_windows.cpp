@@ -109,7 +109,8 @@ bool platform_make_overlay(GLFWwindow *window) {
     SetLayeredWindowAttributes(g_window, 0, 255, LWA_ALPHA);
 
     // Events need to be subscribed here because Windblows doesn't allow
-    // another thread to subscribe events and other one to consume
+    // another thread to subscribe events and other one to consume.
+    // The hook is called from the GLFW event loop on this thread.
     setup_hook();
 
     return true;
@@ -145,10 +146,9 @@ void platform_find_game_window() {
     platform_update_ui_position(rect.left, rect.top, rect.bottom - rect.top, true);
 }
 
-void platform_update() {
-    MSG msg;
-    while (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE)) {
-        TranslateMessage(&msg);
-        DispatchMessage(&msg);
+void platform_stop() {
+    if (g_h_win_event_hook != nullptr) {
+        UnhookWinEvent(g_h_win_event_hook);
+        g_h_win_event_hook = nullptr;
     }
 }
@@ -0,0 +1,483 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+// Based on text rendering example from: https://learnopengl.com
+
+#include "renderer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include <glad/gl.h> // NOLINT
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include "logging.h"
+
+#include "gui_constants.hpp"
+#include "shaders.hpp"
+
+#include "generated-src/font_atlas.h"
+
+namespace {
+
+// Constants
+#define TEXT_COLOR_GREEN glm::vec3(0.5, 1.0F, 0.2F)
+#define TEXT_COLOR_RED glm::vec3(1.0, 0.2F, 0.2F)
+#define FONT_CHARS FONT_ATLAS_CHARS
+// The signed distance field atlas is scaled to the requested font size
+#define FONT_SCALE ((float) FONT_SIZE / FONT_ATLAS_GLYPH_SIZE)
+#define MAX_LINE_CHARS 64
+#define VERTICES_PER_CHAR 6
+#define MAX_LINE_VERTICES (MAX_LINE_CHARS * VERTICES_PER_CHAR)
+#define MAX_TEXT_VERTICES (STAT_LINES * MAX_LINE_VERTICES)
+// Samples of each timeline series, at 120 Hz distance fills this in about 4 seconds
+#define TIMELINE_SAMPLES 512
+#define TIMELINE_SERIES 2
+// Frame advantage is centered and clamped to +-TIMELINE_ADVANTAGE_RANGE
+#define TIMELINE_ADVANTAGE_RANGE 20.0F
+#define TIMELINE_DISTANCE_RANGE 8.0F
+
+struct FontChar {
+    glm::vec2 uv_min; // Top-left corner of the glyph in the atlas
+    glm::vec2 uv_max; // Bottom-right corner of the glyph in the atlas
+    glm::ivec2 size; // Size of glyph
+    glm::ivec2 bearing; // Offset from baseline to left/top of glyph
+    int advance; // Horizontal offset to advance to next glyph
+};
+
+struct TextVertex {
+    float x, y;
+    float u, v;
+    float r, g, b;
+};
+
+// Text shown on an overlay line, the mesh is rebuilt only when it changes
+struct TextLine {
+    char text[MAX_LINE_CHARS + 1];
+    glm::vec3 color;
+};
+
+// Sample rings written by the analyser thread, samples ever written are published last
+float g_timeline_values[TIMELINE_SERIES][TIMELINE_SAMPLES];
+std::atomic<uint32_t> g_timeline_written[TIMELINE_SERIES];
+// GUI thread state of the uploaded samples
+uint32_t g_timeline_uploaded[TIMELINE_SERIES];
+int g_timeline_head[TIMELINE_SERIES];
+int g_timeline_count[TIMELINE_SERIES];
+unsigned int g_timeline_vao, g_timeline_buffer, g_timeline_texture;
+unsigned int g_timeline_program;
+int g_timeline_head_location, g_timeline_count_location;
+
+FontChar g_font_chars[FONT_CHARS];
+unsigned int g_font_atlas;
+// Each line owns a fixed range of the vertex buffer
+TextLine g_text_lines[STAT_LINES];
+TextVertex g_line_vertices[MAX_LINE_VERTICES];
+GLint g_line_first[STAT_LINES];
+GLsizei g_line_count[STAT_LINES];
+unsigned int g_vao, g_vbo;
+unsigned int g_shader_program;
+
+RenderStats g_stats = {};
+
+/**
+ * Lay out text as glyph quads
+ *
+ * @return vertex count
+ */
+int render_text(const char *text, float x, float y, float scale, glm::vec3 color, TextVertex *vertices) {
+    int count = 0;
+    for (const char *c = text; *c != '\0' && count < MAX_LINE_VERTICES; c++) {
+        const FontChar &ch = g_font_chars[(unsigned char) *c % FONT_CHARS];
+
+        const float xpos = x + ((float) ch.bearing.x * scale);
+        const float ypos = y - ((float) (ch.size.y - ch.bearing.y) * scale);
+
+        const float w = (float) ch.size.x * scale;
+        const float h = (float) ch.size.y * scale;
+
+        const TextVertex top_left = {xpos, ypos + h, ch.uv_min.x, ch.uv_min.y, color.x, color.y, color.z};
+        const TextVertex bottom_left = {xpos, ypos, ch.uv_min.x, ch.uv_max.y, color.x, color.y, color.z};
+        const TextVertex bottom_right = {xpos + w, ypos, ch.uv_max.x, ch.uv_max.y, color.x, color.y, color.z};
+        const TextVertex top_right = {xpos + w, ypos + h, ch.uv_max.x, ch.uv_min.y, color.x, color.y, color.z};
+
+        TextVertex *vertex = &vertices[count]; // NOLINT
+        vertex[0] = top_left;
+        vertex[1] = bottom_left;
+        vertex[2] = bottom_right;
+        vertex[3] = top_left;
+        vertex[4] = bottom_right;
+        vertex[5] = top_right;
+        count += VERTICES_PER_CHAR;
+
+        x += (float) ch.advance * scale;
+    }
+    return count;
+}
+
+/**
+ * Set text of an overlay line, the line mesh is updated only if the text or color has changed
+ */
+void render_line(const char *text, int line, glm::vec3 color) {
+    TextLine &cached = g_text_lines[line]; // NOLINT
+    if (cached.color == color && strncmp(cached.text, text, sizeof(cached.text)) == 0) {
+        return;
+    }
+
+    (void) snprintf(cached.text, sizeof(cached.text), "%s", text);
+    cached.color = color;
+
+    const int count =
+        render_text(text, 0, (float) ((FONT_SIZE * line) + TEXT_MARGIN), FONT_SCALE, color, g_line_vertices);
+    g_line_count[line] = count; // NOLINT
+
+    glBindBuffer(GL_ARRAY_BUFFER, g_vbo);
+    g_stats.buffer_uploads++;
+    glBufferSubData(GL_ARRAY_BUFFER,
+                    (GLintptr) (g_line_first[line] * sizeof(TextVertex)), // NOLINT
+                    (GLsizeiptr) (count * sizeof(TextVertex)),
+                    g_line_vertices);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+/**
+ * Draw all overlay lines with a single draw call
+ */
+void draw_text() {
+    glUseProgram(g_shader_program);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, g_font_atlas);
+    glBindVertexArray(g_vao);
+
+    g_stats.draw_calls++;
+    glMultiDrawArrays(GL_TRIANGLES, g_line_first, g_line_count, STAT_LINES);
+
+    glBindVertexArray(0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+/**
+ * Upload samples written since the last frame, one call per series and no per-sample work
+ */
+void update_timeline() {
+    glBindBuffer(GL_TEXTURE_BUFFER, g_timeline_buffer);
+    for (int series = 0; series < TIMELINE_SERIES; series++) {
+        const uint32_t written = g_timeline_written[series].load(std::memory_order_acquire);
+        const uint32_t pending = written - g_timeline_uploaded[series];
+        if (pending == 0) {
+            continue;
+        }
+
+        g_timeline_uploaded[series] = written;
+        g_timeline_count[series] = (int) std::min<uint32_t>(written, TIMELINE_SAMPLES);
+        // Oldest sample, the ring size divides the counter range
+        g_timeline_head[series] = written < TIMELINE_SAMPLES ? 0 : (int) (written % TIMELINE_SAMPLES);
+
+        // Upload the whole series if the written range wraps around
+        int first = (int) ((written - pending) % TIMELINE_SAMPLES);
+        int count = (int) std::min<uint32_t>(pending, TIMELINE_SAMPLES);
+        if (first + count > TIMELINE_SAMPLES) {
+            first = 0;
+            count = TIMELINE_SAMPLES;
+        }
+
+        g_stats.buffer_uploads++;
+        glBufferSubData(GL_TEXTURE_BUFFER,
+                        (GLintptr) (((series * TIMELINE_SAMPLES) + first) * sizeof(float)),
+                        (GLsizeiptr) (count * sizeof(float)),
+                        &g_timeline_values[series][first]); // NOLINT
+    }
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
+
+/**
+ * Draw both timeline series and the zero line with a single instanced draw call
+ */
+void draw_timeline() {
+    glUseProgram(g_timeline_program);
+    glUniform1iv(g_timeline_head_location, TIMELINE_SERIES, g_timeline_head);
+    glUniform1iv(g_timeline_count_location, TIMELINE_SERIES, g_timeline_count);
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_BUFFER, g_timeline_texture);
+    glBindVertexArray(g_timeline_vao);
+
+    g_stats.draw_calls++;
+    glDrawArraysInstanced(GL_LINES, 0, 2, (TIMELINE_SERIES * (TIMELINE_SAMPLES - 1)) + 1);
+
+    glBindVertexArray(0);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+}
+
+unsigned int create_program(const char *vertex_source, const char *fragment_source) {
+    const unsigned int vs = glCreateShader(GL_VERTEX_SHADER);
+    if (vs == 0) {
+        log_error("failed to create vertex shader");
+        return 0;
+    }
+    glShaderSource(vs, 1, &vertex_source, nullptr);
+    glCompileShader(vs);
+
+    const unsigned int fs = glCreateShader(GL_FRAGMENT_SHADER);
+    if (fs == 0) {
+        log_error("failed to create fragment shader");
+        glDeleteShader(vs);
+        return 0;
+    }
+    glShaderSource(fs, 1, &fragment_source, nullptr);
+    glCompileShader(fs);
+
+    const unsigned int program = glCreateProgram();
+    glAttachShader(program, vs);
+    glAttachShader(program, fs);
+    glLinkProgram(program);
+
+    glDeleteShader(vs);
+    glDeleteShader(fs);
+
+    int linked = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (linked == 0) {
+        char info[512];
+        glGetProgramInfoLog(program, sizeof(info), nullptr, info);
+        log_error("failed to link shader program: %s", info);
+        glDeleteProgram(program);
+        return 0;
+    }
+
+    return program;
+}
+
+bool setup_timeline(const glm::mat4 &projection) {
+    g_timeline_program = create_program(TIMELINE_VERTEX_SHADER_SOURCE, TIMELINE_FRAGMENT_SHADER_SOURCE);
+    if (g_timeline_program == 0) {
+        return false;
+    }
+
+    const float value_scale[TIMELINE_SERIES * 2] = {
+        0.5F, 0.5F / TIMELINE_ADVANTAGE_RANGE, 0.0F, 1.0F / TIMELINE_DISTANCE_RANGE};
+
+    glUseProgram(g_timeline_program);
+    glUniformMatrix4fv(
+        glGetUniformLocation(g_timeline_program, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
+    glUniform1i(glGetUniformLocation(g_timeline_program, "samples"), 0);
+    glUniform1i(glGetUniformLocation(g_timeline_program, "sampleCount"), TIMELINE_SAMPLES);
+    glUniform2fv(glGetUniformLocation(g_timeline_program, "valueScale"), TIMELINE_SERIES, value_scale);
+    glUniform4f(glGetUniformLocation(g_timeline_program, "rect"),
+                TIMELINE_X,
+                TEXT_MARGIN,
+                TIMELINE_WIDTH,
+                TIMELINE_HEIGHT);
+    g_timeline_head_location = glGetUniformLocation(g_timeline_program, "head");
+    g_timeline_count_location = glGetUniformLocation(g_timeline_program, "count");
+
+    // Samples are fetched from a texture buffer, the draw has no vertex attributes
+    glGenVertexArrays(1, &g_timeline_vao);
+    glGenBuffers(1, &g_timeline_buffer);
+    glBindBuffer(GL_TEXTURE_BUFFER, g_timeline_buffer);
+    glBufferData(GL_TEXTURE_BUFFER, TIMELINE_SERIES * TIMELINE_SAMPLES * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+    glGenTextures(1, &g_timeline_texture);
+    glBindTexture(GL_TEXTURE_BUFFER, g_timeline_texture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_R32F, g_timeline_buffer);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+
+    return true;
+}
+
+bool setup_text() {
+    g_shader_program = create_program(VERTEX_SHADER_SOURCE, FRAGMENT_SHADER_SOURCE);
+    if (g_shader_program == 0) {
+        return false;
+    }
+
+    glm::mat4 projection = glm::ortho(0.0F, (float) MAX_WIDTH, 0.0F, (float) MAX_HEIGTH);
+    glUseProgram(g_shader_program);
+    glUniformMatrix4fv(glGetUniformLocation(g_shader_program, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
+
+
+    // Configure VAO/VBO for texture quads
+    glGenVertexArrays(1, &g_vao);
+    glGenBuffers(1, &g_vbo);
+    glBindVertexArray(g_vao);
+    glBindBuffer(GL_ARRAY_BUFFER, g_vbo);
+
+    glBufferData(GL_ARRAY_BUFFER, MAX_TEXT_VERTICES * sizeof(TextVertex), nullptr, GL_DYNAMIC_DRAW);
+    for (int line = 0; line < STAT_LINES; line++) {
+        g_line_first[line] = line * MAX_LINE_VERTICES; // NOLINT
+        g_line_count[line] = 0; // NOLINT
+    }
+    // Position and texture coordinates
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(TextVertex), nullptr);
+    // Color
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(
+        1, 3, GL_FLOAT, GL_FALSE, sizeof(TextVertex), (void *) offsetof(TextVertex, r)); // NOLINT
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+
+    if (!setup_timeline(projection)) {
+        log_error("failed to set up timeline");
+        return false;
+    }
+
+    return true;
+}
+
+void set_blending() {
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+}
+
+void load_font() {
+    // Glyph metrics and the atlas are generated at build time
+    for (int c = 0; c < FONT_CHARS; c++) {
+        const FontAtlasGlyph &glyph = font_atlas_glyphs[c]; // NOLINT
+        g_font_chars[c] = { // NOLINT
+            .uv_min = glm::vec2((float) glyph.x / FONT_ATLAS_WIDTH, (float) glyph.y / FONT_ATLAS_HEIGHT),
+            .uv_max = glm::vec2((float) (glyph.x + glyph.width) / FONT_ATLAS_WIDTH,
+                                (float) (glyph.y + glyph.height) / FONT_ATLAS_HEIGHT),
+            .size = glm::ivec2(glyph.width, glyph.height),
+            .bearing = glm::ivec2(glyph.bearing_x, glyph.bearing_y),
+            .advance = glyph.advance};
+    }
+
+    // Disable byte-alignment restriction, as the atlas rows aren't aligned to 4-bytes
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    glGenTextures(1, &g_font_atlas);
+    glBindTexture(GL_TEXTURE_2D, g_font_atlas);
+    glTexImage2D(GL_TEXTURE_2D,
+                 0,
+                 GL_RED, // Use GL_RED for single-channel distance field
+                 FONT_ATLAS_WIDTH,
+                 FONT_ATLAS_HEIGHT,
+                 0,
+                 GL_RED,
+                 GL_UNSIGNED_BYTE,
+                 font_atlas_data);
+
+    // Texture parameters
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void draw_frame_data(const OverlayState &state) {
+    char buffer[MAX_LINE_CHARS + 1];
+
+    (void) snprintf(buffer, sizeof(buffer), DISTANCE, state.distance);
+    render_line(buffer, 0, TEXT_COLOR_GREEN);
+
+    (void) snprintf(buffer, sizeof(buffer), STATUS, FrameDataAnalyser::player_status(state.status));
+    render_line(buffer, 1, TEXT_COLOR_GREEN);
+
+    if (state.data_point.knock_down) {
+        render_line(FRAME_ADVANTAGE_KD, 2, TEXT_COLOR_GREEN);
+    } else {
+        (void) snprintf(buffer, sizeof(buffer), FRAME_ADVANTAGE, state.data_point.frame_advantage);
+        if (state.data_point.frame_advantage < 0) {
+            render_line(buffer, 2, TEXT_COLOR_RED);
+        } else {
+            render_line(buffer, 2, TEXT_COLOR_GREEN);
+        }
+    }
+
+    (void) snprintf(buffer, sizeof(buffer), STARTUP_FRAMES, state.data_point.startup_frames);
+    render_line(buffer, 3, TEXT_COLOR_GREEN);
+}
+
+void draw_no_frame_data(const OverlayState &state) {
+    char buffer[MAX_LINE_CHARS + 1];
+
+    (void) snprintf(buffer, sizeof(buffer), DISTANCE, state.distance);
+    render_line(buffer, 0, TEXT_COLOR_GREEN);
+
+    (void) snprintf(buffer, sizeof(buffer), STATUS, FrameDataAnalyser::player_status(state.status));
+    render_line(buffer, 1, TEXT_COLOR_GREEN);
+
+    render_line(NO_FRAME_ADVANTAGE, 2, TEXT_COLOR_GREEN);
+    render_line(NO_STARTUP_FRAMES, 3, TEXT_COLOR_GREEN);
+}
+
+void draw_no_game() {
+    render_line(NO_DISTANCE, 0, TEXT_COLOR_GREEN);
+    render_line(NO_STATUS, 1, TEXT_COLOR_GREEN);
+    render_line(NO_FRAME_ADVANTAGE, 2, TEXT_COLOR_GREEN);
+    render_line(NO_STARTUP_FRAMES_NO_GAME, 3, TEXT_COLOR_GREEN);
+}
+
+void draw_game_state(const OverlayState &state) {
+    if (state.frame_data_valid) {
+        draw_frame_data(state);
+    } else {
+        draw_no_frame_data(state);
+    }
+}
+
+} // namespace
+
+bool renderer_init() {
+    if (!setup_text()) {
+        log_error("setting up shaders has failed");
+        return false;
+    }
+
+    set_blending();
+    load_font();
+
+    return true;
+}
+
+void renderer_draw(const OverlayState &state) {
+    g_stats = {};
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    if (state.game_hooked) {
+        draw_game_state(state);
+    } else {
+        draw_no_game();
+    }
+    draw_text();
+
+    update_timeline();
+    draw_timeline();
+}
+
+void renderer_push_timeline_samples(const TimelineSeries series, const float value, const uint32_t count) {
+    const uint32_t written = g_timeline_written[series].load(std::memory_order_relaxed);
+    // Older repeats would be overwritten in the same call
+    for (uint32_t i = count - std::min<uint32_t>(count, TIMELINE_SAMPLES); i < count; i++) {
+        g_timeline_values[series][(written + i) % TIMELINE_SAMPLES] = value; // NOLINT
+    }
+    g_timeline_written[series].store(written + count, std::memory_order_release);
+}
+
+RenderStats renderer_stats() {
+    return g_stats;
+}
@@ -0,0 +1,71 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef RENDERER_HPP
+#define RENDERER_HPP
+
+#include <cstdint>
+
+#include "frame_data_analyser.hpp"
+
+enum TimelineSeries : uint8_t {
+    TIMELINE_ADVANTAGE,
+    TIMELINE_DISTANCE
+};
+
+// Overlay content of a single frame
+struct OverlayState {
+    bool game_hooked;
+    bool frame_data_valid; // Frame data is recent enough to be shown
+    FrameDataPoint data_point;
+    float distance;
+    PlayerState status;
+};
+
+// GL work done for the last drawn frame
+struct RenderStats {
+    int draw_calls;
+    int buffer_uploads;
+};
+
+/**
+ * Set up shaders, buffers and the font atlas
+ *
+ * GL functions have to be loaded and the context current on the calling thread.
+ *
+ * @return true on success
+ */
+bool renderer_init();
+/**
+ * Draw the overlay to the current framebuffer
+ *
+ * @param state overlay content
+ */
+void renderer_draw(const OverlayState &state);
+/**
+ * Append samples to a timeline series, callable from a single producer thread
+ *
+ * The GUI thread uploads them on the next draw. A producer more than a full
+ * series ahead of the GUI thread may tear the samples being uploaded.
+ *
+ * @param series timeline series
+ * @param value sample value
+ * @param count times the value is appended, one per analyser tick for distance
+ */
+void renderer_push_timeline_samples(const TimelineSeries series, const float value, const uint32_t count);
+RenderStats renderer_stats();
+
+#endif
@@ -21,7 +21,9 @@
 constexpr const static char *VERTEX_SHADER_SOURCE = R"glsl(
     #version 330 core
     layout (location = 0) in vec4 vertex; // <vec2 pos, vec2 tex>
+    layout (location = 1) in vec3 vertexColor;
     out vec2 TexCoords;
+    out vec3 textColor;
 
     uniform mat4 projection;
 
@@ -29,23 +31,92 @@ constexpr const static char *VERTEX_SHADER_SOURCE = R"glsl(
     {
         gl_Position = projection * vec4(vertex.xy, 0.0, 1.0);
         TexCoords = vertex.zw;
+        textColor = vertexColor;
     }
 )glsl";
 
 constexpr const static char *FRAGMENT_SHADER_SOURCE = R"glsl(
     #version 330 core
     in vec2 TexCoords;
+    in vec3 textColor;
     out vec4 color;
 
     uniform sampler2D text;
-    uniform vec3 textColor;
 
     void main()
     {
-        // The glyph texture is single-channel (red), so we sample it.
-        // The 'r' component gives us the alpha value for anti-aliasing.
-        vec4 sampled = vec4(1.0, 1.0, 1.0, texture(text, TexCoords).r);
-        color = vec4(textColor, 1.0) * sampled;
+        // The atlas holds a signed distance field in the red channel
+        // with the glyph outline at 0.5. Smoothing over one screen pixel
+        // keeps the edges sharp at any scale.
+        float distance = texture(text, TexCoords).r;
+        float smoothing = fwidth(distance) * 0.5;
+        float alpha = smoothstep(0.5 - smoothing, 0.5 + smoothing, distance);
+        color = vec4(textColor, alpha);
+    }
+)glsl";
+
+// Timeline of sample history, one instance per line segment
+constexpr const static char *TIMELINE_VERTEX_SHADER_SOURCE = R"glsl(
+    #version 330 core
+    flat out vec3 lineColor;
+
+    uniform mat4 projection;
+    uniform samplerBuffer samples; // Ring buffer of each series back to back
+    uniform int sampleCount; // Ring buffer size of a series
+    uniform int head[2]; // Oldest sample of a series
+    uniform int count[2]; // Valid samples of a series
+    uniform vec2 valueScale[2]; // <offset, scale> from value to rect height
+    uniform vec4 rect; // <x, y, width, height>
+
+    const vec3 ADVANTAGE_COLOR = vec3(0.5, 1.0, 0.2);
+    const vec3 DISADVANTAGE_COLOR = vec3(1.0, 0.2, 0.2);
+    const vec3 DISTANCE_COLOR = vec3(0.4, 0.7, 1.0);
+    const vec3 BASELINE_COLOR = vec3(0.5, 0.5, 0.5);
+
+    void main()
+    {
+        int segments = sampleCount - 1;
+
+        // The last instance is the zero line of frame advantage
+        if (gl_InstanceID == 2 * segments) {
+            float y = rect.y + (valueScale[0].x * rect.w);
+            gl_Position = projection * vec4(rect.x + (float(gl_VertexID) * rect.z), y, 0.0, 1.0);
+            lineColor = BASELINE_COLOR;
+            return;
+        }
+
+        int series = gl_InstanceID / segments;
+        int segment = gl_InstanceID % segments;
+        if (segment >= count[series] - 1) {
+            // Outside of the clip space
+            gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+            lineColor = BASELINE_COLOR;
+            return;
+        }
+
+        // Newest sample is at the right edge
+        int sampleIndex = segment + gl_VertexID;
+        float value = texelFetch(samples, (series * sampleCount) + ((head[series] + sampleIndex) % sampleCount)).r;
+        float x = rect.x + (rect.z * float(sampleIndex + sampleCount - count[series]) / float(segments));
+        float y = rect.y + (clamp(valueScale[series].x + (value * valueScale[series].y), 0.0, 1.0) * rect.w);
+        gl_Position = projection * vec4(x, y, 0.0, 1.0);
+
+        if (series == 0) {
+            lineColor = value < 0.0 ? DISADVANTAGE_COLOR : ADVANTAGE_COLOR;
+        } else {
+            lineColor = DISTANCE_COLOR;
+        }
+    }
+)glsl";
+
+constexpr const static char *TIMELINE_FRAGMENT_SHADER_SOURCE = R"glsl(
+    #version 330 core
+    flat in vec3 lineColor;
+    out vec4 color;
+
+    void main()
+    {
+        color = vec4(lineColor, 0.8);
     }
 )glsl";
 
@@ -21,15 +21,148 @@
 #include <string.h>
 
 #include "address_config.h"
+#include "bulk_decode.h"
 #include "logging.h"
 #include "memory_reader.h"
 #include "memory_reader_types.h"
 #include "number_conversions.h"
+#include "read_stats.h"
+
+// Fields of a player, in read order
+enum PlayerField {
+    PLAYER_FRAMES_LAST_ACTION,
+    PLAYER_CONNECTION,
+    PLAYER_RECOVERY_FRAMES,
+    PLAYER_INTENT,
+    PLAYER_MOVE,
+    PLAYER_STATE,
+    PLAYER_STRING_TYPE,
+    PLAYER_STRING_STATE,
+    PLAYER_POSITION,
+    PLAYER_ATTACK_SEQ,
+    PLAYER_FIELD_COUNT
+};
+
+// Game frame fields, the game frame number followed by both players' fields
+#define FIELD_GAME_FRAME 0
+#define FIELD_P1 1
+#define FIELD_P2 (FIELD_P1 + PLAYER_FIELD_COUNT)
+#define FRAME_FIELD_COUNT (FIELD_P2 + PLAYER_FIELD_COUNT)
+
+struct FrameField {
+    uint64_t address;
+    // Width of a value and number of consecutive values
+    uint8_t width;
+    uint8_t count;
+    const char *name;
+    // Offset in the snapshot
+    uint16_t offset;
+};
 
 static uint64_t g_player_side_address = 0;
 static uint64_t g_p1_attack_seq_address = 0;
 static uint64_t g_p2_attack_seq_address = 0;
 
+static struct FrameField g_fields[FRAME_FIELD_COUNT];
+static struct BulkDecodeLayout g_frame_layout;
+static struct BulkDecodeLayout g_position_layout;
+// Big-endian fields of a game frame, decoded in place
+static uint8_t g_snapshot[BULK_DECODE_MAX_SIZE];
+
+static int init_frame_layout(void) {
+    const struct FrameField fields[FRAME_FIELD_COUNT] = {
+        [FIELD_GAME_FRAME] = {CURRENT_GAME_FRAME, 4, 1, "game frame", 0},
+        [FIELD_P1 + PLAYER_FRAMES_LAST_ACTION] = {P1_FRAMES_LAST_ACTION, 4, 1, "p1 frames last action", 0},
+        [FIELD_P1 + PLAYER_CONNECTION] = {P1_CONNECTION_BOOL, 2, 1, "p1 connection", 0},
+        [FIELD_P1 + PLAYER_RECOVERY_FRAMES] = {P1_RECOVERY_FRAMES, 4, 1, "p1 recovery frames", 0},
+        [FIELD_P1 + PLAYER_INTENT] = {P1_INTENT, 4, 1, "p1 intent", 0},
+        [FIELD_P1 + PLAYER_MOVE] = {P1_MOVE, 4, 1, "p1 move", 0},
+        [FIELD_P1 + PLAYER_STATE] = {P1_STATE, 4, 1, "p1 state", 0},
+        [FIELD_P1 + PLAYER_STRING_TYPE] = {P1_STRING_TYPE, 4, 1, "p1 string type", 0},
+        [FIELD_P1 + PLAYER_STRING_STATE] = {P1_STRING_STATE, 4, 1, "p1 string state", 0},
+        [FIELD_P1 + PLAYER_POSITION] = {P1_POSITION, 4, 3, "p1 position", 0},
+        [FIELD_P1 + PLAYER_ATTACK_SEQ] = {g_p1_attack_seq_address, 4, 1, "p1 attack seq", 0},
+        [FIELD_P2 + PLAYER_FRAMES_LAST_ACTION] = {P2_FRAMES_LAST_ACTION, 4, 1, "p2 frames last action", 0},
+        [FIELD_P2 + PLAYER_CONNECTION] = {P2_CONNECTION_BOOL, 2, 1, "p2 connection", 0},
+        [FIELD_P2 + PLAYER_RECOVERY_FRAMES] = {P2_RECOVERY_FRAMES, 4, 1, "p2 recovery frames", 0},
+        [FIELD_P2 + PLAYER_INTENT] = {P2_INTENT, 4, 1, "p2 intent", 0},
+        [FIELD_P2 + PLAYER_MOVE] = {P2_MOVE, 4, 1, "p2 move", 0},
+        [FIELD_P2 + PLAYER_STATE] = {P2_STATE, 4, 1, "p2 state", 0},
+        [FIELD_P2 + PLAYER_STRING_TYPE] = {P2_STRING_TYPE, 4, 1, "p2 string type", 0},
+        [FIELD_P2 + PLAYER_STRING_STATE] = {P2_STRING_STATE, 4, 1, "p2 string state", 0},
+        [FIELD_P2 + PLAYER_POSITION] = {P2_POSITION, 4, 3, "p2 position", 0},
+        [FIELD_P2 + PLAYER_ATTACK_SEQ] = {g_p2_attack_seq_address, 4, 1, "p2 attack seq", 0},
+    };
+    memcpy(g_fields, fields, sizeof(g_fields)); // NOLINT
+
+    // Width map with a value per coordinate
+    uint8_t widths[BULK_DECODE_MAX_FIELDS];
+    uint32_t first_value[FRAME_FIELD_COUNT];
+    uint32_t value_count = 0;
+    for (int i = 0; i < FRAME_FIELD_COUNT; i++) {
+        first_value[i] = value_count;
+        for (int value = 0; value < g_fields[i].count; value++) {
+            widths[value_count++] = g_fields[i].width;
+        }
+    }
+
+    if (bulk_decode_layout_init(&g_frame_layout, widths, value_count) != 0) {
+        log_error("invalid game frame layout");
+        return MR_INIT_ERROR;
+    }
+
+    for (int i = 0; i < FRAME_FIELD_COUNT; i++) {
+        g_fields[i].offset = g_frame_layout.offsets[first_value[i]];
+    }
+
+    const uint8_t position_widths[] = {4, 4, 4};
+    if (bulk_decode_layout_init(&g_position_layout, position_widths, 3) != 0) {
+        log_error("invalid position layout");
+        return MR_INIT_ERROR;
+    }
+
+    return MR_INIT_OK;
+}
+
+static void name_read_stats(void) {
+    read_stats_name(PLAYER_SIDE_PTR, "player side ptr");
+    read_stats_name(P1_ATTACK_SEQ_PTR, "p1 attack seq ptr");
+    read_stats_name(P2_ATTACK_SEQ_PTR, "p2 attack seq ptr");
+
+    for (int i = 0; i < FRAME_FIELD_COUNT; i++) {
+        read_stats_name(g_fields[i].address, g_fields[i].name);
+    }
+
+    read_stats_name(g_player_side_address, "player side");
+}
+
+static inline int32_t snapshot_int32(const int field) {
+    int32_t value = 0;
+    memcpy(&value, &g_snapshot[g_fields[field].offset], sizeof(value)); // NOLINT
+    return value;
+}
+
+static inline int16_t snapshot_int16(const int field) {
+    int16_t value = 0;
+    memcpy(&value, &g_snapshot[g_fields[field].offset], sizeof(value)); // NOLINT
+    return value;
+}
+
+static void snapshot_player(struct PlayerFrame *player, const int first) {
+    player->frames_last_action = snapshot_int32(first + PLAYER_FRAMES_LAST_ACTION);
+    player->connection = (int8_t) snapshot_int16(first + PLAYER_CONNECTION);
+    player->recovery_frames = (uint32_t) snapshot_int32(first + PLAYER_RECOVERY_FRAMES);
+    player->intent = snapshot_int32(first + PLAYER_INTENT);
+    player->move = snapshot_int32(first + PLAYER_MOVE);
+    player->state = snapshot_int32(first + PLAYER_STATE);
+    player->string_type = snapshot_int32(first + PLAYER_STRING_TYPE);
+    player->string_state = snapshot_int32(first + PLAYER_STRING_STATE);
+    memcpy(&player->position, // NOLINT
+           &g_snapshot[g_fields[first + PLAYER_POSITION].offset],
+           sizeof(player->position));
+    player->attack_seq = snapshot_int32(first + PLAYER_ATTACK_SEQ);
+}
+
 int init_memory_reader(void) {
     if (platform_init_memory_reader() == MR_INIT_ERROR) {
         return MR_INIT_ERROR;
@@ -61,6 +194,13 @@ int init_memory_reader(void) {
     value += P2_ATTACK_SEQ_OFFSET;
     g_p2_attack_seq_address = ps3_address_to_x64((uint32_t) value);
 
+    if (init_frame_layout() == MR_INIT_ERROR) {
+        return MR_INIT_ERROR;
+    }
+
+    if (read_stats_enabled()) {
+        name_read_stats();
+    }
 
     return MR_INIT_OK;
 }
@@ -103,9 +243,7 @@ int p1_position(struct PlayerCoordinate *value) {
         return READ_ERROR;
     }
 
-    value->x = big32_to_little_float((char *) value);
-    value->y = big32_to_little_float(&((char *) value)[4]);
-    value->z = big32_to_little_float(&((char *) value)[8]);
+    bulk_decode(&g_position_layout, value, value);
 
     return READ_OK;
 }
@@ -152,9 +290,7 @@ int p2_position(struct PlayerCoordinate *value) {
         return READ_ERROR;
     }
 
-    value->x = big32_to_little_float((char *) value);
-    value->y = big32_to_little_float(&((char *) value)[4]);
-    value->z = big32_to_little_float(&((char *) value)[8]);
+    bulk_decode(&g_position_layout, value, value);
 
     return READ_OK;
 }
@@ -176,160 +312,21 @@ uint64_t player_side_address(void) {
 }
 
 int read_game_state(struct GameFrame *state) {
-    int32_t value = 0;
-    struct PlayerCoordinate coords = {0, 0, 0};
-
-    int result = current_game_frame((uint32_t *) &value);
-
-    if (result == READ_ERROR) {
-        log_debug("readed invalid game frame number");
-        return READ_ERROR;
-    }
-    state->game_frame = (uint32_t) value;
-
-    result = p1_frames_last_action(&value);
-    if (result == READ_ERROR) {
-        log_debug("readed invalid p1 last action frames");
-        return READ_ERROR;
-    }
-    state->p1.frames_last_action = value;
-
-    result = p1_connection((int16_t *) &value);
-    if (result == READ_ERROR) {
-        log_debug("readed invalid p1 last connection frames");
-        return READ_ERROR;
-    }
-    state->p1.connection = (int16_t) value; // NOLINT
-
-    result = p1_recovery_frames((uint32_t *) &value);
-    if (result == READ_ERROR) {
-        log_debug("readed invalid p1 recovery frames");
-        return READ_ERROR;
-    }
-    state->p1.recovery_frames = (uint32_t) value;
-
-    result = p1_intent(&value);
-    if (result == READ_ERROR) {
-        log_debug("readed invalid p1 intent");
-        return READ_ERROR;
-    }
-    state->p1.intent = value;
-
-    result = p1_move(&value);
-    if (result == READ_ERROR) {
-        log_debug("readed invalid p1 move");
-        return READ_ERROR;
-    }
-    state->p1.move = value;
-
-    result = p1_state(&value);
-    if (result == READ_ERROR) {
-        log_debug("readed invalid p1 state");
-        return READ_ERROR;
-    }
-    state->p1.state = value;
-
-    result = p1_string_type(&value);
-    if (result == READ_ERROR) {
-        log_debug("readed invalid p1 string type");
-        return READ_ERROR;
-    }
-    state->p1.string_type = value;
-
-    result = p1_string_state(&value);
-    if (result == READ_ERROR) {
-        log_debug("readed invalid p1 string state");
-        return READ_ERROR;
-    }
-    state->p1.string_state = value;
-
-    result = p1_position(&coords);
-    if (result == READ_ERROR) {
-        log_debug("readed invalid p1 state");
-        return READ_ERROR;
-    }
-    state->p1.position = coords;
-
-    result = p1_attack_seq(&value);
-    if (result == READ_ERROR) {
-        log_debug("readed invalid p1 attack seq");
-        return READ_ERROR;
-    }
-    state->p1.attack_seq = value;
-
-
-    result = p2_frames_last_action(&value);
-    if (result == READ_ERROR) {
-        log_debug("readed invalid p2 last action frames");
-        return READ_ERROR;
+    // Raw reads into the snapshot, then one decode of the whole frame
+    for (int i = 0; i < FRAME_FIELD_COUNT; i++) {
+        const struct FrameField *field = &g_fields[i];
+        const size_t size = (size_t) field->width * field->count;
+        if (read_bytes_raw((long long) field->address, &g_snapshot[field->offset], size) == READ_ERROR) {
+            log_debug("readed invalid %s", field->name);
+            return READ_ERROR;
+        }
     }
-    state->p2.frames_last_action = value;
 
-    result = p2_connection((int16_t *) &value);
-    if (result == READ_ERROR) {
-        log_debug("readed invalid p2 last connection frames");
-        return READ_ERROR;
-    }
-    state->p2.connection = (int16_t) value; // NOLINT
+    bulk_decode(&g_frame_layout, g_snapshot, g_snapshot);
 
-    result = p2_recovery_frames((uint32_t *) &value);
-    if (result == READ_ERROR) {
-        log_debug("readed invalid p2 recovery frames");
-        return READ_ERROR;
-    }
-    state->p2.recovery_frames = value;
-
-    result = p2_intent(&value);
-    if (result == READ_ERROR) {
-        log_debug("readed invalid p2 intent");
-        return READ_ERROR;
-    }
-    state->p2.intent = value;
-
-    result = p2_move(&value);
-    if (result == READ_ERROR) {
-        log_debug("readed invalid p2 move");
-        return READ_ERROR;
-    }
-    state->p2.move = value;
-
-    result = p2_state(&value);
-    if (result == READ_ERROR) {
-        log_debug("readed invalid p2 state");
-        return READ_ERROR;
-    }
-    state->p2.state = value;
-
-    result = p2_string_type(&value);
-    if (result == READ_ERROR) {
-        log_debug("readed invalid p2 string type");
-        return READ_ERROR;
-    }
-    state->p2.string_type = value;
-
-    result = p2_string_state(&value);
-    if (result == READ_ERROR) {
-        log_debug("readed invalid p2 string state");
-        return READ_ERROR;
-    }
-    state->p2.string_state = value;
-
-    memset(&coords, 0, sizeof(coords)); // NOLINT
-
-    result = p2_position(&coords);
-
-    if (result == READ_ERROR) {
-        log_debug("readed invalid p1 state");
-        return READ_ERROR;
-    }
-    state->p2.position = coords;
-
-    result = p2_attack_seq(&value);
-    if (result == READ_ERROR) {
-        log_debug("readed invalid p2 attack seq");
-        return READ_ERROR;
-    }
-    state->p2.attack_seq = value;
+    state->game_frame = (uint32_t) snapshot_int32(FIELD_GAME_FRAME);
+    snapshot_player(&state->p1, FIELD_P1);
+    snapshot_player(&state->p2, FIELD_P2);
 
     return 0;
 }
@@ -24,6 +24,9 @@ extern "C" {
 
 #include <stdint.h>
 
+// Bump when the fields of GameFrame change, frame traces record it
+#define GAME_FRAME_LAYOUT_VERSION 1
+
 struct PlayerCoordinate {
     float x;
     float y;
@@ -18,6 +18,10 @@
 #ifndef MEMORY_READER_H
 #define MEMORY_READER_H
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 #include <stddef.h>
 #include <stdint.h>
 
@@ -27,9 +31,19 @@
  * @return MR_INIT value
  */
 int platform_init_memory_reader(void);
+/**
+ * Attach to the given process instead of searching for the emulator by name
+ *
+ * @param pid process ID, -1 to search by name
+ */
+void set_emulator_pid(const int pid);
 
 int read_bytes_raw(const long long address, void *buf, const size_t size);
 int read_4bytes(const long long address, int32_t *value);
 int read_2bytes(const long long address, int16_t *value);
 
+#ifdef __cplusplus
+};
+#endif
+
 #endif
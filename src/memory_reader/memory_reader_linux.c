@@ -17,6 +17,7 @@
 
 #define _GNU_SOURCE // NOLINT
 #include <dirent.h>
+#include <fcntl.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -24,12 +25,14 @@
 
 #include <sys/types.h>
 #include <sys/uio.h>
+#include <unistd.h>
 
 #include "logging.h"
 #include "number_conversions.h"
 
 #include "memory_reader.h"
 #include "memory_reader_types.h"
+#include "read_stats.h"
 
 /*
  * Memory reader for linux platforms
@@ -39,9 +42,12 @@
 // Constants
 #define READ_BUFFER_LEN 12
 #define RPCS3_NAME "rpcs3"
+// Enough for the emulator's argv[0], longer command lines are truncated
+#define CMDLINE_BUFFER_LEN 4096
 
 // UIO variables
 static pid_t g_pid = -1;
+static pid_t g_target_pid = -1;
 static char g_buf[READ_BUFFER_LEN];
 static struct iovec g_local[1];
 static struct iovec g_remote[1];
@@ -50,11 +56,22 @@ static inline void set_read_address(void *address) {
     g_remote[0].iov_base = address;
 }
 
-int read_bytes_raw(const long long address, void *buf, const size_t size) {
+static inline size_t read_remote(const long long address, const size_t size) {
     g_local[0].iov_len = size;
     set_read_address((void *) address); // NOLINT
 
-    const size_t nread = process_vm_readv(g_pid, g_local, 1, g_remote, 1, 0);
+    if (!read_stats_enabled()) {
+        return process_vm_readv(g_pid, g_local, 1, g_remote, 1, 0);
+    }
+
+    const uint64_t start = read_stats_now_ns();
+    const ssize_t nread = process_vm_readv(g_pid, g_local, 1, g_remote, 1, 0);
+    read_stats_record((uint64_t) address, size, nread, read_stats_now_ns() - start);
+    return (size_t) nread;
+}
+
+int read_bytes_raw(const long long address, void *buf, const size_t size) {
+    const size_t nread = read_remote(address, size);
     if (nread != size) {
         log_error("failed to read %zu bytes (%zu)", size, nread);
         return -1;
@@ -65,10 +82,7 @@ int read_bytes_raw(const long long address, void *buf, const size_t size) {
 }
 
 int read_4bytes(const long long address, int32_t *value) {
-    g_local[0].iov_len = 4;
-    set_read_address((void *) address); // NOLINT
-
-    const size_t nread = process_vm_readv(g_pid, g_local, 1, g_remote, 1, 0);
+    const size_t nread = read_remote(address, 4);
     if (nread != 4) {
         log_error("failed to read 4 bytes (%zu)", nread);
         return READ_ERROR;
@@ -78,10 +92,7 @@ int read_4bytes(const long long address, int32_t *value) {
 }
 
 int read_2bytes(const long long address, int16_t *value) {
-    g_local[0].iov_len = 2;
-    set_read_address((void *) address); // NOLINT
-
-    const size_t nread = process_vm_readv(g_pid, g_local, 1, g_remote, 1, 0);
+    const size_t nread = read_remote(address, 2);
     if (nread != 2) {
         log_error("failed to read 2 bytes (%zu)", nread);
         return READ_ERROR;
@@ -114,27 +125,30 @@ pid_t get_pid(char *name) {
             continue;
         }
 
-        // Check the process name from cmdline
+        // Check the process name from cmdline, argv[0] is the first null terminated string
         char cmdline_file[1024] = {0};
         sprintf(cmdline_file, "%s/%d/cmdline", directory, pid); // NOLINT
 
-        FILE *cmdline = fopen(cmdline_file, "r");
+        const int cmdline = open(cmdline_file, O_RDONLY | O_CLOEXEC);
+        if (cmdline == -1) {
+            // Process has exited or is not accessible
+            continue;
+        }
 
-        size_t bytes_read = 0;
-        char *process_name = NULL;
+        char process_name[CMDLINE_BUFFER_LEN];
+        const ssize_t bytes_read = read(cmdline, process_name, sizeof(process_name) - 1);
+        (void) close(cmdline);
 
-        if (getline(&process_name, &bytes_read, cmdline) <= 0) { // NOLINT
-            (void) fclose(cmdline); // NOLINT
+        if (bytes_read <= 0) {
             continue;
         }
+        process_name[bytes_read] = '\0';
 
         if (strstr(process_name, name) == 0) {
-            (void) fclose(cmdline);
             continue;
         }
 
         // Found PID close streams
-        (void) fclose(cmdline);
         closedir(dir);
 
         return pid;
@@ -145,8 +159,12 @@ pid_t get_pid(char *name) {
     return -1;
 }
 
+void set_emulator_pid(const int pid) {
+    g_target_pid = pid;
+}
+
 int platform_init_memory_reader(void) {
-    g_pid = get_pid(RPCS3_NAME);
+    g_pid = g_target_pid > 0 ? g_target_pid : get_pid(RPCS3_NAME);
 
     if (g_pid == -1) {
         log_error("cannot find the emulator process");
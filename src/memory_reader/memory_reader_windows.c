@@ -28,6 +28,7 @@
 #include "memory_reader.h"
 #include "memory_reader_types.h"
 #include "number_conversions.h"
+#include "read_stats.h"
 
 
 /*
@@ -45,6 +46,7 @@
 // Win32 API variables
 static HANDLE g_h_process = NULL; // Process handle for memory reading
 static char g_buf[READ_BUFFER_LEN];
+static DWORD g_target_pid = 0;
 
 static DWORD get_pid_by_name(const char *processName) {
     PROCESSENTRY32 entry;
@@ -75,8 +77,14 @@ static DWORD get_pid_by_name(const char *processName) {
 
 int read_bytes_raw(const long long address, void *buf, const size_t size) {
     SIZE_T bytes_read = 0;
+    const uint64_t start = read_stats_enabled() ? read_stats_now_ns() : 0;
     // Use ReadProcessMemory instead of process_vm_readv
-    if (ReadProcessMemory(g_h_process, (LPCVOID) address, buf, size, &bytes_read) == 0) { // NOLINT
+    const BOOL success = ReadProcessMemory(g_h_process, (LPCVOID) address, buf, size, &bytes_read); // NOLINT
+    if (read_stats_enabled()) {
+        read_stats_record((uint64_t) address, size, success ? (long long) bytes_read : -1, read_stats_now_ns() - start);
+    }
+
+    if (success == 0) {
         log_error("ReadProcessMemory failed with error code: %lu", GetLastError());
         return -1;
     }
@@ -108,8 +116,12 @@ int read_2bytes(const long long address, int16_t *value) {
     return READ_OK;
 }
 
+void set_emulator_pid(const int pid) {
+    g_target_pid = pid > 0 ? (DWORD) pid : 0;
+}
+
 int platform_init_memory_reader(void) {
-    DWORD pid = get_pid_by_name(RPCS3_NAME);
+    DWORD pid = g_target_pid != 0 ? g_target_pid : get_pid_by_name(RPCS3_NAME);
 
     if (pid == 0) {
         log_error("cannot find the emulator process: %s", RPCS3_NAME);
@@ -0,0 +1,138 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "read_stats.h"
+
+#include <time.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#include "logging.h"
+
+static int g_enabled = 0;
+static size_t g_count = 0;
+static struct ReadStats g_stats[READ_STATS_MAX_ADDRESSES];
+
+void read_stats_enable(void) {
+    g_enabled = 1;
+}
+
+int read_stats_enabled(void) {
+    return g_enabled;
+}
+
+static struct ReadStats *find_stats(const uint64_t address, const uint32_t size) {
+    const size_t count = __atomic_load_n(&g_count, __ATOMIC_RELAXED);
+    for (size_t i = 0; i < count; i++) {
+        if (g_stats[i].address == address) {
+            return &g_stats[i];
+        }
+    }
+
+    // Last entry is shared by the addresses which do not fit
+    if (count == READ_STATS_MAX_ADDRESSES) {
+        return &g_stats[READ_STATS_MAX_ADDRESSES - 1];
+    }
+
+    struct ReadStats *stats = &g_stats[count];
+    stats->address = count == READ_STATS_MAX_ADDRESSES - 1 ? 0 : address;
+    stats->size = size;
+    // Publish the entry after it has been set up
+    __atomic_store_n(&g_count, count + 1, __ATOMIC_RELEASE);
+    return stats;
+}
+
+void read_stats_name(const uint64_t address, const char *name) {
+    struct ReadStats *stats = find_stats(address, 0);
+    if (stats->address == address) {
+        stats->name = name;
+    }
+}
+
+void read_stats_record(const uint64_t address, const size_t size, const long long nread, const uint64_t ns) {
+    struct ReadStats *stats = find_stats(address, (uint32_t) size);
+    stats->size = (uint32_t) size;
+
+    if (nread < 0) {
+        __atomic_store_n(&stats->errors, stats->errors + 1, __ATOMIC_RELAXED);
+    } else if ((size_t) nread != size) {
+        __atomic_store_n(&stats->partial_reads, stats->partial_reads + 1, __ATOMIC_RELAXED);
+    }
+
+    latency_histogram_record(&stats->latency, ns);
+}
+
+uint64_t read_stats_now_ns(void) {
+#ifdef _WIN32
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (uint64_t) ((double) counter.QuadPart * 1e9 / (double) frequency.QuadPart);
+#else
+    struct timespec time;
+    (void) clock_gettime(CLOCK_MONOTONIC_RAW, &time);
+    return ((uint64_t) time.tv_sec * 1000000000ULL) + (uint64_t) time.tv_nsec;
+#endif
+}
+
+size_t read_stats_count(void) {
+    return __atomic_load_n(&g_count, __ATOMIC_ACQUIRE);
+}
+
+const struct ReadStats *read_stats_get(const size_t index) {
+    return &g_stats[index];
+}
+
+void read_stats_log_summary(void) {
+    const size_t count = read_stats_count();
+    if (count == 0) {
+        log_info("read stats: no reads");
+        return;
+    }
+
+    log_info("read stats: %-22s %-12s %4s %10s %8s %8s %10s %8s %7s",
+             "field",
+             "address",
+             "size",
+             "reads",
+             "p50 us",
+             "p99 us",
+             "max us",
+             "partial",
+             "errors");
+    for (size_t i = 0; i < count; i++) {
+        const struct ReadStats *stats = &g_stats[i];
+        const char *name = stats->name;
+        if (name == NULL) {
+            name = stats->address == 0 ? "(other)" : "-";
+        }
+
+        log_info("read stats: %-22s 0x%010llx %4u %10llu %8.1f %8.1f %10.1f %8llu %7llu",
+                 name,
+                 (unsigned long long) stats->address,
+                 stats->size,
+                 (unsigned long long) latency_histogram_count(&stats->latency),
+                 (double) latency_histogram_percentile(&stats->latency, 50) / 1000.0,
+                 (double) latency_histogram_percentile(&stats->latency, 99) / 1000.0,
+                 (double) latency_histogram_max(&stats->latency) / 1000.0,
+                 (unsigned long long) __atomic_load_n(&stats->partial_reads, __ATOMIC_RELAXED),
+                 (unsigned long long) __atomic_load_n(&stats->errors, __ATOMIC_RELAXED));
+    }
+}
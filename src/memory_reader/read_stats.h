@@ -0,0 +1,96 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/*
+  Optional latency and failure statistics of the remote reads
+
+  Statistics are kept per remote address, each game state field is read
+  from its own address. Recording is done by the reader thread, any thread
+  can read the statistics.
+*/
+
+#ifndef READ_STATS_H
+#define READ_STATS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "latency_histogram.h"
+
+// Addresses tracked separately, reads of further addresses share the last entry
+#define READ_STATS_MAX_ADDRESSES 48
+
+struct ReadStats {
+    // Remote address, 0 for the shared entry of untracked addresses
+    uint64_t address;
+    // Field name or NULL
+    const char *name;
+    uint32_t size;
+    uint64_t partial_reads;
+    uint64_t errors;
+    struct LatencyHistogram latency;
+};
+
+/**
+ * Start recording remote reads, call before the memory reader is initialized
+ */
+void read_stats_enable(void);
+int read_stats_enabled(void);
+
+/**
+ * Name the field read from an address for the summary
+ *
+ * @param address remote address
+ * @param name field name, must outlive the statistics
+ */
+void read_stats_name(const uint64_t address, const char *name);
+
+/**
+ * Record a remote read (reader thread only)
+ *
+ * @param address remote address
+ * @param size requested bytes
+ * @param nread read bytes, negative on error
+ * @param ns read latency
+ */
+void read_stats_record(const uint64_t address, const size_t size, const long long nread, const uint64_t ns);
+uint64_t read_stats_now_ns(void);
+
+/**
+ * @return number of tracked addresses
+ */
+size_t read_stats_count(void);
+/**
+ * @param index index below read_stats_count()
+ * @return statistics of the address
+ */
+const struct ReadStats *read_stats_get(const size_t index);
+
+/**
+ * Log latency percentiles, partial reads and errors of every address
+ */
+void read_stats_log_summary(void);
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif
@@ -0,0 +1,239 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdint.h>
+#include <string.h>
+
+#include "bulk_decode.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BULK_DECODE_X86
+#endif
+
+#define BLOCK_SIZE 16
+#define KERNEL_UNSELECTED BULK_DECODE_KERNELS
+
+typedef void (*DecodeFunction)(const struct BulkDecodeLayout *layout, uint8_t *dst, const uint8_t *src);
+
+static int g_kernel = KERNEL_UNSELECTED;
+
+static void decode_scalar(const struct BulkDecodeLayout *layout, uint8_t *dst, const uint8_t *src) {
+    // Padding between fields is copied as is
+    if (dst != src) {
+        memcpy(dst, src, layout->size); // NOLINT
+    }
+
+    for (uint32_t i = 0; i < layout->field_count; i++) {
+        uint8_t *field = &dst[layout->offsets[i]];
+        switch (layout->widths[i]) {
+        case 2: {
+            uint16_t value = 0;
+            memcpy(&value, field, sizeof(value)); // NOLINT
+            value = __builtin_bswap16(value);
+            memcpy(field, &value, sizeof(value)); // NOLINT
+            break;
+        }
+        case 4: {
+            uint32_t value = 0;
+            memcpy(&value, field, sizeof(value)); // NOLINT
+            value = __builtin_bswap32(value);
+            memcpy(field, &value, sizeof(value)); // NOLINT
+            break;
+        }
+        case 8: {
+            uint64_t value = 0;
+            memcpy(&value, field, sizeof(value)); // NOLINT
+            value = __builtin_bswap64(value);
+            memcpy(field, &value, sizeof(value)); // NOLINT
+            break;
+        }
+        default:
+            break;
+        }
+    }
+}
+
+#ifdef BULK_DECODE_X86
+
+/**
+ * Shuffle the bytes after the last full block
+ *
+ * @param begin start of the partial block, multiple of BLOCK_SIZE
+ */
+static inline void decode_tail(const struct BulkDecodeLayout *layout, uint8_t *dst, const uint8_t *src,
+                               const uint32_t begin) {
+    const uint32_t length = layout->size - begin;
+    if (length == 0) {
+        return;
+    }
+
+    // Copy first, dst may be src
+    uint8_t block[BLOCK_SIZE];
+    memcpy(block, &src[begin], length); // NOLINT
+    for (uint32_t i = 0; i < length; i++) {
+        dst[begin + i] = block[layout->shuffle[begin + i]];
+    }
+}
+
+__attribute__((target("ssse3"))) static void decode_ssse3(const struct BulkDecodeLayout *layout, uint8_t *dst,
+                                                          const uint8_t *src) {
+    uint32_t offset = 0;
+    for (; offset + BLOCK_SIZE <= layout->size; offset += BLOCK_SIZE) {
+        const __m128i mask = _mm_loadu_si128((const __m128i *) &layout->shuffle[offset]); // NOLINT
+        const __m128i bytes = _mm_loadu_si128((const __m128i *) &src[offset]); // NOLINT
+        _mm_storeu_si128((__m128i *) &dst[offset], _mm_shuffle_epi8(bytes, mask)); // NOLINT
+    }
+    decode_tail(layout, dst, src, offset);
+}
+
+__attribute__((target("avx2"))) static void decode_avx2(const struct BulkDecodeLayout *layout, uint8_t *dst,
+                                                        const uint8_t *src) {
+    // vpshufb shuffles within 128-bit lanes, the block relative table works as is
+    uint32_t offset = 0;
+    for (; offset + (2 * BLOCK_SIZE) <= layout->size; offset += 2 * BLOCK_SIZE) {
+        const __m256i mask = _mm256_loadu_si256((const __m256i *) &layout->shuffle[offset]); // NOLINT
+        const __m256i bytes = _mm256_loadu_si256((const __m256i *) &src[offset]); // NOLINT
+        _mm256_storeu_si256((__m256i *) &dst[offset], _mm256_shuffle_epi8(bytes, mask)); // NOLINT
+    }
+
+    if (offset + BLOCK_SIZE <= layout->size) {
+        const __m128i mask = _mm_loadu_si128((const __m128i *) &layout->shuffle[offset]); // NOLINT
+        const __m128i bytes = _mm_loadu_si128((const __m128i *) &src[offset]); // NOLINT
+        _mm_storeu_si128((__m128i *) &dst[offset], _mm_shuffle_epi8(bytes, mask)); // NOLINT
+        offset += BLOCK_SIZE;
+    }
+    decode_tail(layout, dst, src, offset);
+}
+
+static const DecodeFunction KERNELS[BULK_DECODE_KERNELS] = {decode_scalar, decode_ssse3, decode_avx2};
+
+#else
+
+static const DecodeFunction KERNELS[BULK_DECODE_KERNELS] = {decode_scalar, NULL, NULL};
+
+#endif
+
+static int best_kernel(void) {
+#ifdef BULK_DECODE_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return BULK_DECODE_AVX2;
+    }
+    if (__builtin_cpu_supports("ssse3")) {
+        return BULK_DECODE_SSSE3;
+    }
+#endif
+    return BULK_DECODE_SCALAR;
+}
+
+static inline int selected_kernel(void) {
+    int kernel = __atomic_load_n(&g_kernel, __ATOMIC_RELAXED);
+    if (kernel == KERNEL_UNSELECTED) {
+        // Racing threads pick the same kernel
+        kernel = best_kernel();
+        __atomic_store_n(&g_kernel, kernel, __ATOMIC_RELAXED);
+    }
+    return kernel;
+}
+
+int bulk_decode_layout_init(struct BulkDecodeLayout *layout, const uint8_t *widths, const uint32_t count) {
+    memset(layout, 0, sizeof(*layout)); // NOLINT
+    if (count > BULK_DECODE_MAX_FIELDS) {
+        return -1;
+    }
+
+    uint32_t offset = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        const uint32_t width = widths[i];
+        if (width != 1 && width != 2 && width != 4 && width != 8) {
+            return -1;
+        }
+
+        // Natural alignment keeps every field inside one block
+        offset = (offset + width - 1) & ~(width - 1);
+        if (offset + width > BULK_DECODE_MAX_SIZE) {
+            return -1;
+        }
+
+        layout->offsets[i] = (uint16_t) offset;
+        layout->widths[i] = (uint8_t) width;
+        offset += width;
+    }
+
+    layout->field_count = count;
+    layout->size = offset;
+
+    // Identity for padding, reversed bytes for fields
+    for (uint32_t i = 0; i < BULK_DECODE_MAX_SIZE; i++) {
+        layout->shuffle[i] = (uint8_t) (i % BLOCK_SIZE);
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        const uint32_t start = layout->offsets[i];
+        for (uint32_t byte = 0; byte < layout->widths[i]; byte++) {
+            layout->shuffle[start + byte] = (uint8_t) ((start + layout->widths[i] - 1 - byte) % BLOCK_SIZE);
+        }
+    }
+
+    return 0;
+}
+
+void bulk_decode(const struct BulkDecodeLayout *layout, void *dst, const void *src) {
+    KERNELS[selected_kernel()](layout, (uint8_t *) dst, (const uint8_t *) src);
+}
+
+int bulk_decode_kernel_supported(const enum BulkDecodeKernel kernel) {
+    switch (kernel) {
+    case BULK_DECODE_SCALAR:
+        return 1;
+#ifdef BULK_DECODE_X86
+    case BULK_DECODE_SSSE3:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("ssse3") ? 1 : 0;
+    case BULK_DECODE_AVX2:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") ? 1 : 0;
+#endif
+    default:
+        return 0;
+    }
+}
+
+int bulk_decode_set_kernel(const enum BulkDecodeKernel kernel) {
+    if (!bulk_decode_kernel_supported(kernel)) {
+        return -1;
+    }
+    __atomic_store_n(&g_kernel, (int) kernel, __ATOMIC_RELAXED);
+    return 0;
+}
+
+enum BulkDecodeKernel bulk_decode_kernel(void) {
+    return (enum BulkDecodeKernel) selected_kernel();
+}
+
+const char *bulk_decode_kernel_name(const enum BulkDecodeKernel kernel) {
+    switch (kernel) {
+    case BULK_DECODE_SCALAR:
+        return "scalar";
+    case BULK_DECODE_SSSE3:
+        return "ssse3";
+    case BULK_DECODE_AVX2:
+        return "avx2";
+    default:
+        return "unknown";
+    }
+}
@@ -0,0 +1,96 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/*
+  Bulk big-endian decoder for guest memory snapshots
+
+  A layout is built once from the width of every field. Fields are placed
+  at naturally aligned offsets, as in a C struct of the same fields, so no
+  field crosses a 16-byte block and the whole snapshot can be byte-swapped
+  with one shuffle per block: 32 bytes per AVX2 shuffle, 16 bytes per SSSE3
+  shuffle and a scalar tail. The kernel is picked from the CPU features on
+  first use. Requires GCC or Clang builtins.
+*/
+
+#ifndef BULK_DECODE_H
+#define BULK_DECODE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#define BULK_DECODE_MAX_FIELDS 64
+// Snapshot size limit in bytes, the game frame takes 100
+#define BULK_DECODE_MAX_SIZE 256
+
+enum BulkDecodeKernel {
+    BULK_DECODE_SCALAR,
+    BULK_DECODE_SSSE3,
+    BULK_DECODE_AVX2,
+    BULK_DECODE_KERNELS
+};
+
+struct BulkDecodeLayout {
+    uint32_t field_count;
+    // Snapshot size in bytes, end of the last field
+    uint32_t size;
+    uint16_t offsets[BULK_DECODE_MAX_FIELDS];
+    uint8_t widths[BULK_DECODE_MAX_FIELDS];
+    // Source byte of every snapshot byte, relative to its 16-byte block
+    uint8_t shuffle[BULK_DECODE_MAX_SIZE];
+};
+
+/**
+ * Build a layout from a field width map
+ *
+ * @param layout layout
+ * @param widths field widths in bytes, 1, 2, 4 or 8
+ * @param count number of fields
+ * @return 0 on success, -1 if the fields are invalid or do not fit
+ */
+int bulk_decode_layout_init(struct BulkDecodeLayout *layout, const uint8_t *widths, const uint32_t count);
+/**
+ * Byte-swap every field of a snapshot, dst and src may be the same buffer
+ *
+ * @param layout layout of the snapshot
+ * @param dst decoded snapshot, layout->size bytes
+ * @param src big-endian snapshot, layout->size bytes
+ */
+void bulk_decode(const struct BulkDecodeLayout *layout, void *dst, const void *src);
+
+/**
+ * @param kernel kernel
+ * @return 1 if the CPU can run the kernel
+ */
+int bulk_decode_kernel_supported(const enum BulkDecodeKernel kernel);
+/**
+ * Override the kernel picked at runtime, for tests and benchmarks
+ *
+ * @param kernel kernel
+ * @return 0 on success, -1 if the kernel is not supported
+ */
+int bulk_decode_set_kernel(const enum BulkDecodeKernel kernel);
+enum BulkDecodeKernel bulk_decode_kernel(void);
+const char *bulk_decode_kernel_name(const enum BulkDecodeKernel kernel);
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif
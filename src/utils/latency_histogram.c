@@ -0,0 +1,100 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdint.h>
+#include <string.h>
+
+#include "latency_histogram.h"
+
+#define SUB_BUCKETS (1U << LATENCY_HISTOGRAM_SUB_BITS)
+
+static inline uint32_t bucket_index(const uint64_t ns) {
+    if (ns < SUB_BUCKETS) {
+        return (uint32_t) ns;
+    }
+
+    const uint32_t exponent = 63 - (uint32_t) __builtin_clzll(ns);
+    if (exponent > LATENCY_HISTOGRAM_MAX_EXPONENT) {
+        return LATENCY_HISTOGRAM_BUCKETS - 1;
+    }
+
+    const uint32_t sub = (uint32_t) (ns >> (exponent - LATENCY_HISTOGRAM_SUB_BITS)) & (SUB_BUCKETS - 1);
+    return ((exponent - LATENCY_HISTOGRAM_SUB_BITS + 1) << LATENCY_HISTOGRAM_SUB_BITS) + sub;
+}
+
+static inline uint64_t bucket_upper_bound(const uint32_t index) {
+    if (index < SUB_BUCKETS) {
+        return index;
+    }
+
+    const uint32_t exponent = (index >> LATENCY_HISTOGRAM_SUB_BITS) + LATENCY_HISTOGRAM_SUB_BITS - 1;
+    const uint64_t width = 1ULL << (exponent - LATENCY_HISTOGRAM_SUB_BITS);
+    const uint64_t lower = (SUB_BUCKETS + (index & (SUB_BUCKETS - 1))) * width;
+    return lower + width - 1;
+}
+
+void latency_histogram_clear(struct LatencyHistogram *histogram) {
+    memset(histogram, 0, sizeof(*histogram)); // NOLINT
+}
+
+void latency_histogram_record(struct LatencyHistogram *histogram, const uint64_t ns) {
+    // Single writer, relaxed stores keep concurrent readers free of torn values
+    uint32_t *bucket = &histogram->buckets[bucket_index(ns)];
+    __atomic_store_n(bucket, __atomic_load_n(bucket, __ATOMIC_RELAXED) + 1, __ATOMIC_RELAXED);
+    __atomic_store_n(&histogram->count, __atomic_load_n(&histogram->count, __ATOMIC_RELAXED) + 1, __ATOMIC_RELAXED);
+
+    if (ns > __atomic_load_n(&histogram->max_ns, __ATOMIC_RELAXED)) {
+        __atomic_store_n(&histogram->max_ns, ns, __ATOMIC_RELAXED);
+    }
+}
+
+uint64_t latency_histogram_percentile(const struct LatencyHistogram *histogram, const double percentile) {
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < LATENCY_HISTOGRAM_BUCKETS; i++) {
+        total += __atomic_load_n(&histogram->buckets[i], __ATOMIC_RELAXED);
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    // Rank of the percentile, at least the first value
+    uint64_t rank = (uint64_t) ((percentile / 100.0 * (double) total) + 0.5);
+    if (rank == 0) {
+        rank = 1;
+    }
+
+    const uint64_t max_ns = latency_histogram_max(histogram);
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < LATENCY_HISTOGRAM_BUCKETS; i++) {
+        seen += __atomic_load_n(&histogram->buckets[i], __ATOMIC_RELAXED);
+        if (seen >= rank) {
+            // Last bucket has no upper bound
+            const uint64_t bound = i == LATENCY_HISTOGRAM_BUCKETS - 1 ? max_ns : bucket_upper_bound(i);
+            return bound < max_ns ? bound : max_ns;
+        }
+    }
+
+    return max_ns;
+}
+
+uint64_t latency_histogram_count(const struct LatencyHistogram *histogram) {
+    return __atomic_load_n(&histogram->count, __ATOMIC_RELAXED);
+}
+
+uint64_t latency_histogram_max(const struct LatencyHistogram *histogram) {
+    return __atomic_load_n(&histogram->max_ns, __ATOMIC_RELAXED);
+}
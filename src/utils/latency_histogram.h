@@ -0,0 +1,69 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/*
+  Fixed-bucket latency histogram
+
+  Buckets are log-linear, every power of two is split into 8 buckets so
+  percentiles are within 12.5% of the recorded values. Recording is meant
+  for a single writer, any thread can read a histogram while it is being
+  written. Requires GCC or Clang atomic builtins.
+*/
+
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#define LATENCY_HISTOGRAM_SUB_BITS 3
+// Values up to 2^40 ns (about 18 minutes), larger ones land in the last bucket
+#define LATENCY_HISTOGRAM_MAX_EXPONENT 40
+#define LATENCY_HISTOGRAM_BUCKETS \
+    ((LATENCY_HISTOGRAM_MAX_EXPONENT - LATENCY_HISTOGRAM_SUB_BITS + 2) << LATENCY_HISTOGRAM_SUB_BITS)
+
+struct LatencyHistogram {
+    uint64_t count;
+    uint64_t max_ns;
+    uint32_t buckets[LATENCY_HISTOGRAM_BUCKETS];
+};
+
+void latency_histogram_clear(struct LatencyHistogram *histogram);
+/**
+ * Record a value (single writer)
+ *
+ * @param histogram histogram
+ * @param ns value in nanoseconds
+ */
+void latency_histogram_record(struct LatencyHistogram *histogram, const uint64_t ns);
+/**
+ * @param histogram histogram
+ * @param percentile percentile in range 0-100
+ * @return upper bound of the bucket of the percentile, 0 if empty
+ */
+uint64_t latency_histogram_percentile(const struct LatencyHistogram *histogram, const double percentile);
+uint64_t latency_histogram_count(const struct LatencyHistogram *histogram);
+uint64_t latency_histogram_max(const struct LatencyHistogram *histogram);
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif
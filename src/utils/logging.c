@@ -24,8 +24,26 @@
 
 #include "logging.h"
 
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <unistd.h>
+
 #define MAX_CALLBACKS 32
 
+// Asynchronous logging
+#define ASYNC_MAX_THREADS 16
+#define ASYNC_RING_SIZE 128 // Power of two
+#define ASYNC_MESSAGE_SIZE 512
+#define ASYNC_FLUSH_INTERVAL_NS 10000000
+#define ASYNC_OUTPUT_BUFFER_SIZE 65536
+
+#ifdef CLOCK_REALTIME_COARSE
+#define ASYNC_CLOCK CLOCK_REALTIME_COARSE
+#else
+#define ASYNC_CLOCK CLOCK_REALTIME
+#endif
+
 typedef struct {
     log_LogFn fn;
     void *udata;
@@ -41,6 +59,46 @@ static struct {
 } lock_struct;
 
 
+typedef struct {
+    time_t time;
+    const char *file;
+    int line;
+    int level;
+    char message[ASYNC_MESSAGE_SIZE];
+} async_record;
+
+// Single producer (the owning thread), single consumer (the logging thread)
+typedef struct {
+    // Claimed by a thread, released when the thread exits
+    atomic_bool in_use;
+    atomic_size_t write;
+    atomic_size_t read;
+    atomic_uint dropped;
+    async_record records[ASYNC_RING_SIZE];
+} async_ring;
+
+static struct {
+    atomic_bool enabled;
+    atomic_bool running;
+    // Writers between the enabled check and queueing a message
+    atomic_int writers;
+    // Rings ever claimed, released rings are reused before new ones
+    atomic_int ring_count;
+    atomic_bool full_reported;
+    pthread_t thread;
+    // Serialises batches and synchronous messages, held while batching is read or written
+    pthread_mutex_t output_lock;
+    FILE *output;
+    bool batching;
+    async_ring rings[ASYNC_MAX_THREADS];
+} async_struct = {.output_lock = PTHREAD_MUTEX_INITIALIZER};
+
+static _Thread_local async_ring *thread_ring;
+static pthread_key_t ring_key;
+static pthread_once_t ring_key_once = PTHREAD_ONCE_INIT;
+static bool ring_key_created;
+
+
 static const char *level_strings[] = {
     "TRACE", "DEBUG", "INFO", "WARN", "ERROR", "FATAL"
 };
@@ -68,7 +126,9 @@ static void stdout_callback(log_Event *ev) {
 #endif
     (void) vfprintf(ev->udata, ev->fmt, ev->ap);
     (void) fprintf(ev->udata, "\n");
-    (void) fflush(ev->udata);
+    if (!async_struct.batching) {
+        (void) fflush(ev->udata);
+    }
     // NOLINTEND
 }
 
@@ -82,7 +142,9 @@ static void file_callback(log_Event *ev) {
         buf, level_strings[ev->level], ev->file, ev->line);
     (void) vfprintf(ev->udata, ev->fmt, ev->ap);
     (void) fprintf(ev->udata, "\n");
-    (void) fflush(ev->udata);
+    if (!async_struct.batching) {
+        (void) fflush(ev->udata);
+    }
     // NOLINTEND
 }
 
@@ -143,7 +205,258 @@ static void init_event(log_Event *ev, void *udata) {
 }
 
 
+static bool level_enabled(int level) {
+    if (!lock_struct.quiet && level >= lock_struct.level) {
+        return true;
+    }
+    for (int i = 0; i < MAX_CALLBACKS && lock_struct.callbacks[i].fn; i++) {
+        if (level >= lock_struct.callbacks[i].level) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+static void release_thread_ring(void *ring) {
+    // The producer is gone, the next owner continues from its write index
+    thread_ring = NULL;
+    atomic_store_explicit(&((async_ring *) ring)->in_use, false, memory_order_release);
+}
+
+
+static void create_ring_key(void) {
+    // Without the key rings are kept until the process exits
+    ring_key_created = pthread_key_create(&ring_key, release_thread_ring) == 0;
+}
+
+
+static async_ring *claim_ring(void) {
+    for (int i = 0; i < ASYNC_MAX_THREADS; i++) {
+        async_ring *ring = &async_struct.rings[i];
+        bool expected = false;
+        if (!atomic_compare_exchange_strong_explicit(&ring->in_use, &expected, true, memory_order_acquire,
+                                                     memory_order_relaxed)) {
+            continue;
+        }
+
+        // Visible to the logging thread before the first message
+        int count = atomic_load(&async_struct.ring_count);
+        while (count <= i && !atomic_compare_exchange_weak(&async_struct.ring_count, &count, i + 1)) {
+        }
+        return ring;
+    }
+    return NULL;
+}
+
+
+static async_ring *get_thread_ring(void) {
+    if (thread_ring == NULL) {
+        async_ring *ring = claim_ring();
+        if (ring == NULL) {
+            if (!atomic_exchange(&async_struct.full_reported, true)) {
+                log_warn("More than %d threads logging, logging the rest synchronously", ASYNC_MAX_THREADS);
+            }
+            return NULL;
+        }
+
+        (void) pthread_once(&ring_key_once, create_ring_key);
+        if (ring_key_created) {
+            (void) pthread_setspecific(ring_key, ring);
+        }
+        thread_ring = ring;
+    }
+    return thread_ring;
+}
+
+
+static bool async_log(int level, const char *file, int line, const char *fmt, va_list ap) {
+    async_ring *ring = get_thread_ring();
+    if (ring == NULL) {
+        // Too many threads, log synchronously
+        return false;
+    }
+
+    const size_t write = atomic_load_explicit(&ring->write, memory_order_relaxed);
+    if (write - atomic_load_explicit(&ring->read, memory_order_acquire) == ASYNC_RING_SIZE) {
+        atomic_fetch_add_explicit(&ring->dropped, 1, memory_order_relaxed);
+        return true;
+    }
+
+    async_record *record = &ring->records[write & (ASYNC_RING_SIZE - 1)];
+    struct timespec now;
+    clock_gettime(ASYNC_CLOCK, &now);
+    record->time = now.tv_sec;
+    record->file = file;
+    record->line = line;
+    record->level = level;
+    (void) vsnprintf(record->message, sizeof(record->message), fmt, ap); // NOLINT
+
+    atomic_store_explicit(&ring->write, write + 1, memory_order_release);
+    return true;
+}
+
+
+// Pass already formatted message to callback
+static void dispatch(log_LogFn fn, log_Event *ev, ...) {
+    va_start(ev->ap, ev);
+    fn(ev);
+    va_end(ev->ap);
+}
+
+
+static void write_record(const async_record *record, struct tm *time) {
+    log_Event ev = {
+        .fmt     = "%s",
+        .file    = record->file,
+        .line    = record->line,
+        .level   = record->level,
+        .time    = time,
+    };
+
+    if (!lock_struct.quiet && record->level >= lock_struct.level) {
+        ev.udata = async_struct.output;
+        dispatch(stdout_callback, &ev, record->message);
+    }
+
+    for (int i = 0; i < MAX_CALLBACKS && lock_struct.callbacks[i].fn; i++) {
+        callback *cb = &lock_struct.callbacks[i];
+        if (record->level >= cb->level) {
+            ev.udata = cb->udata;
+            dispatch(cb->fn, &ev, record->message);
+        }
+    }
+}
+
+
+static void write_rings(void) {
+    // Cached local time, updated when the second changes
+    static time_t cached_second = -1;
+    static struct tm cached_time;
+
+    const int ring_count = atomic_load(&async_struct.ring_count);
+
+    lock();
+    pthread_mutex_lock(&async_struct.output_lock);
+    async_struct.batching = true;
+
+    for (int i = 0; i < ring_count && i < ASYNC_MAX_THREADS; i++) {
+        async_ring *ring = &async_struct.rings[i];
+        size_t read = atomic_load_explicit(&ring->read, memory_order_relaxed);
+        const size_t write = atomic_load_explicit(&ring->write, memory_order_acquire);
+
+        for (; read != write; read++) {
+            const async_record *record = &ring->records[read & (ASYNC_RING_SIZE - 1)];
+            if (record->time != cached_second) {
+                cached_second = record->time;
+                cached_time = *localtime(&cached_second); // NOLINT only used by the logging thread
+            }
+            write_record(record, &cached_time);
+        }
+        atomic_store_explicit(&ring->read, read, memory_order_release);
+
+        const unsigned dropped = atomic_exchange_explicit(&ring->dropped, 0, memory_order_relaxed);
+        if (dropped > 0) {
+            (void) fprintf(async_struct.output, "%u log messages dropped\n", dropped); // NOLINT
+        }
+    }
+
+    // Flush the whole batch at once
+    (void) fflush(async_struct.output);
+    for (int i = 0; i < MAX_CALLBACKS && lock_struct.callbacks[i].fn; i++) {
+        if (lock_struct.callbacks[i].fn == file_callback) {
+            (void) fflush(lock_struct.callbacks[i].udata);
+        }
+    }
+
+    async_struct.batching = false;
+    pthread_mutex_unlock(&async_struct.output_lock);
+    unlock();
+}
+
+
+static void *async_loop(void *arg) {
+    (void) arg;
+    const struct timespec interval = {.tv_sec = 0, .tv_nsec = ASYNC_FLUSH_INTERVAL_NS};
+
+    while (atomic_load(&async_struct.running)) {
+        nanosleep(&interval, NULL);
+        write_rings();
+    }
+
+    write_rings();
+    return NULL;
+}
+
+
+int log_start_async(void) {
+    static char output_buffer[ASYNC_OUTPUT_BUFFER_SIZE];
+
+    if (atomic_load(&async_struct.running)) {
+        return 0;
+    }
+
+    // Buffered stream to stderr, flushed once per batch
+    if (async_struct.output == NULL) {
+        FILE *output = fdopen(dup(fileno(stderr)), "w");
+        if (output == NULL) {
+            return -1;
+        }
+        (void) setvbuf(output, output_buffer, _IOFBF, sizeof(output_buffer));
+
+        pthread_mutex_lock(&async_struct.output_lock);
+        async_struct.output = output;
+        pthread_mutex_unlock(&async_struct.output_lock);
+    }
+
+    atomic_store(&async_struct.running, true);
+    if (pthread_create(&async_struct.thread, NULL, async_loop, NULL) != 0) {
+        atomic_store(&async_struct.running, false);
+        return -1;
+    }
+
+    atomic_store(&async_struct.enabled, true);
+    return 0;
+}
+
+
+void log_stop_async(void) {
+    if (!atomic_load(&async_struct.running)) {
+        return;
+    }
+
+    atomic_store(&async_struct.enabled, false);
+    // Writers which still saw logging enabled queue before the final drain
+    while (atomic_load(&async_struct.writers) > 0) {
+        sched_yield();
+    }
+    atomic_store(&async_struct.running, false);
+    pthread_join(async_struct.thread, NULL);
+}
+
+
 void log_log(int level, const char *file, int line, const char *fmt, ...) {
+    if (atomic_load_explicit(&async_struct.enabled, memory_order_relaxed)) {
+        if (!level_enabled(level)) {
+            return;
+        }
+
+        // Counted before checking again, log_stop_async waits for the count to drop
+        atomic_fetch_add(&async_struct.writers, 1);
+        bool queued = false;
+        if (atomic_load(&async_struct.enabled)) {
+            va_list ap;
+            va_start(ap, fmt);
+            queued = async_log(level, file, line, fmt, ap);
+            va_end(ap);
+        }
+        atomic_fetch_sub(&async_struct.writers, 1);
+
+        if (queued) {
+            return;
+        }
+    }
+
     log_Event ev = {
         .fmt     = fmt,
         .file    = file,
@@ -152,9 +465,12 @@ void log_log(int level, const char *file, int line, const char *fmt, ...) {
     };
 
     lock();
+    pthread_mutex_lock(&async_struct.output_lock);
 
+    // Same stream as the batches once asynchronous logging was started, keeps the order across both
+    FILE *output = async_struct.output != NULL ? async_struct.output : stderr;
     if (!lock_struct.quiet && level >= lock_struct.level) {
-        init_event(&ev, stderr);
+        init_event(&ev, output);
         va_start(ev.ap, fmt);
         stdout_callback(&ev);
         va_end(ev.ap);
@@ -170,5 +486,6 @@ void log_log(int level, const char *file, int line, const char *fmt, ...) {
         }
     }
 
+    pthread_mutex_unlock(&async_struct.output_lock);
     unlock();
 }
@@ -60,6 +60,21 @@ void log_set_quiet(bool enable);
 int log_add_callback(log_LogFn fn, void *udata, int level);
 int log_add_fp(FILE *fp, int level);
 
+/*
+ * Format messages on the calling thread into a per-thread lock-free ring and
+ * write them from a background logging thread. A ring is released when its
+ * thread exits; threads beyond the ring limit log synchronously to the same
+ * stream. Messages keep their order per thread only, a full ring drops
+ * messages and reports the count
+ * @return 0 on success, -1 on error
+ */
+int log_start_async(void);
+/*
+ * Wait for threads still queueing, write pending messages and go back to
+ * synchronous logging
+ */
+void log_stop_async(void);
+
 void log_log(int level, const char *file, int line, const char *fmt, ...);
 
 #ifdef __cplusplus
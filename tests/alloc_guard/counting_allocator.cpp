@@ -0,0 +1,150 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "counting_allocator.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <new>
+
+// glibc's allocator, the replacements forward to it
+extern "C" {
+void *__libc_malloc(size_t size); // NOLINT
+void *__libc_calloc(size_t count, size_t size); // NOLINT
+void *__libc_realloc(void *pointer, size_t size); // NOLINT
+void *__libc_memalign(size_t alignment, size_t size); // NOLINT
+void __libc_free(void *pointer); // NOLINT
+}
+
+namespace {
+std::atomic<bool> g_armed = false;
+std::atomic<size_t> g_total = 0;
+std::atomic<size_t> g_cpp = 0;
+std::atomic<const void *> g_first_caller = nullptr;
+thread_local bool t_tracked = false;
+
+inline bool counted() {
+    return t_tracked && g_armed.load(std::memory_order_relaxed);
+}
+
+inline void count(const void *caller) {
+    if (g_total.fetch_add(1, std::memory_order_relaxed) == 0) {
+        g_first_caller = caller;
+    }
+}
+
+void *new_counted(const size_t size, const void *caller) {
+    if (counted()) {
+        g_cpp.fetch_add(1, std::memory_order_relaxed);
+        count(caller);
+    }
+
+    // Counted above, skip counting in malloc
+    void *pointer = __libc_malloc(size == 0 ? 1 : size);
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+} // namespace
+
+void counting_allocator_track_thread() {
+    t_tracked = true;
+}
+
+void counting_allocator_arm() {
+    g_total = 0;
+    g_cpp = 0;
+    g_first_caller = nullptr;
+    g_armed = true;
+}
+
+AllocationCounts counting_allocator_disarm() {
+    g_armed = false;
+    return {.total = g_total.load(), .cpp = g_cpp.load(), .first_caller = g_first_caller.load()};
+}
+
+//// C allocator
+///
+extern "C" {
+void *malloc(size_t size) { // NOLINT
+    if (counted()) {
+        count(__builtin_return_address(0));
+    }
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count_, size_t size) { // NOLINT
+    if (counted()) {
+        count(__builtin_return_address(0));
+    }
+    return __libc_calloc(count_, size);
+}
+
+void *realloc(void *pointer, size_t size) { // NOLINT
+    if (counted()) {
+        count(__builtin_return_address(0));
+    }
+    return __libc_realloc(pointer, size);
+}
+
+void *aligned_alloc(size_t alignment, size_t size) { // NOLINT
+    if (counted()) {
+        count(__builtin_return_address(0));
+    }
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void **pointer, size_t alignment, size_t size) { // NOLINT
+    if (counted()) {
+        count(__builtin_return_address(0));
+    }
+    *pointer = __libc_memalign(alignment, size);
+    return *pointer == nullptr ? ENOMEM : 0;
+}
+
+void free(void *pointer) { // NOLINT
+    __libc_free(pointer);
+}
+}
+
+//// C++ allocator
+///
+void *operator new(size_t size) {
+    return new_counted(size, __builtin_return_address(0));
+}
+
+void *operator new[](size_t size) {
+    return new_counted(size, __builtin_return_address(0));
+}
+
+void operator delete(void *pointer) noexcept {
+    __libc_free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept {
+    __libc_free(pointer);
+}
+
+void operator delete(void *pointer, size_t /*size*/) noexcept {
+    __libc_free(pointer);
+}
+
+void operator delete[](void *pointer, size_t /*size*/) noexcept {
+    __libc_free(pointer);
+}
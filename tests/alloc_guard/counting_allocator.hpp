@@ -0,0 +1,55 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef COUNTING_ALLOCATOR_HPP
+#define COUNTING_ALLOCATOR_HPP
+
+#include <cstddef>
+
+/*
+  Counting allocator, linking counting_allocator.cpp into an executable
+  replaces malloc and the global operator new with counting versions.
+
+  Only allocations made by tracked threads while counting is armed are
+  counted, so the hot path can be checked without the test harness.
+*/
+
+struct AllocationCounts {
+    // Every heap allocation, includes the ones of C libraries
+    size_t total;
+    // Allocations through the global operator new
+    size_t cpp;
+    // Caller of the first counted allocation
+    const void *first_caller;
+};
+
+/**
+ * Count allocations of the calling thread while armed
+ */
+void counting_allocator_track_thread();
+/**
+ * Reset the counts and start counting
+ */
+void counting_allocator_arm();
+/**
+ * Stop counting
+ *
+ * @return allocations counted while armed
+ */
+AllocationCounts counting_allocator_disarm();
+
+#endif
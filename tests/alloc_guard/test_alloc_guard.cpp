@@ -0,0 +1,76 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "frame_data_analyser.hpp"
+#include "logging.h"
+
+#include "counting_allocator.hpp"
+#include "fake_emulator.hpp"
+
+// Long enough for the analyser to see attacks of the fake script
+#define WARMUP_MS 1200
+#define STEADY_STATE_MS 2500
+
+namespace {
+class Listener : public EventListener {
+public:
+    std::atomic<int> frame_data_count = 0;
+
+    void tick(const TickEvents &events) override {
+        if ((events.changed & TICK_FRAME_DATA) != 0) {
+            frame_data_count++;
+        }
+    }
+};
+} // namespace
+
+TEST(test_alloc_guard, analyser_steady_state) {
+    const FakeEmulator emulator("60", "left");
+    ASSERT_TRUE(emulator.ready());
+
+    // Exercise the frame logging path without the output
+    log_set_quiet(true);
+    FrameDataAnalyser::set_logging(true);
+
+    Listener listener;
+    std::thread analyser([&listener] {
+        counting_allocator_track_thread();
+        FrameDataAnalyser::start(&listener);
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(WARMUP_MS));
+    const int warmup_frame_data = listener.frame_data_count;
+
+    counting_allocator_arm();
+    std::this_thread::sleep_for(std::chrono::milliseconds(STEADY_STATE_MS));
+    const AllocationCounts counts = counting_allocator_disarm();
+
+    FrameDataAnalyser::stop();
+    analyser.join();
+    FrameDataAnalyser::set_logging(false);
+    log_set_quiet(false);
+
+    // Ticks analysed attacks while counting
+    EXPECT_GT(listener.frame_data_count, warmup_frame_data);
+    EXPECT_EQ(counts.total, 0) << counts.cpp << " through operator new, first from " << counts.first_caller;
+}
@@ -0,0 +1,93 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <benchmark/benchmark.h>
+
+#include "frame_data_analyser.hpp"
+#include "logging.h"
+
+#include "synthetic_frames.hpp"
+
+// Analyser frame history is full after ten seconds
+#define HISTORY_FRAMES (60 * 10)
+
+namespace {
+
+class CountingListener : public EventListener {
+public:
+    size_t frame_data = 0;
+
+    void tick(const TickEvents &events) override {
+        if ((events.changed & TICK_FRAME_DATA) != 0) {
+            frame_data++;
+        }
+    }
+};
+
+/**
+ * Feed frames until the analyser's frame history is full
+ *
+ * @return index of the next frame
+ */
+size_t fill_history(const std::vector<GameFrame> &frames, const size_t hits) {
+    // Analyser logging would dominate the measurement
+    log_set_level(LOG_FATAL);
+
+    size_t index = 0;
+    for (; index < HISTORY_FRAMES; index++) {
+        FrameDataAnalyser::process_frame(scenario_frame(frames, hits, index));
+    }
+    return index;
+}
+
+void bm_get_game_frame(benchmark::State &state) {
+    CountingListener listener;
+    FrameDataAnalyser::reset(&listener);
+    const std::vector<GameFrame> frames = scenario_frames(Scenario::SINGLE_HIT);
+    const size_t next = fill_history(frames, 1);
+
+    // Lookup depth from the newest frame
+    const auto depth = (uint32_t) state.range(0);
+    const uint32_t game_frame = SCENARIO_FIRST_FRAME + (uint32_t) next - 1 - depth;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(FrameDataAnalyser::get_game_frame(game_frame));
+    }
+}
+BENCHMARK(bm_get_game_frame)->Arg(1)->Arg(HISTORY_FRAMES / 2)->Arg(HISTORY_FRAMES - 1);
+
+void bm_analyser_tick(benchmark::State &state, const Scenario scenario) {
+    CountingListener listener;
+    FrameDataAnalyser::reset(&listener);
+    const std::vector<GameFrame> frames = scenario_frames(scenario);
+    const size_t hits = scenario_hits(scenario).size();
+    size_t index = fill_history(frames, hits);
+    listener.frame_data = 0;
+
+    for (auto _ : state) {
+        FrameDataAnalyser::process_frame(scenario_frame(frames, hits, index));
+        index++;
+    }
+
+    // One frame data point per round if the scenario is analysed correctly
+    state.counters["frame_data_per_round"] = (double) listener.frame_data * SCENARIO_PERIOD / (double) state.iterations();
+}
+BENCHMARK_CAPTURE(bm_analyser_tick, single_hit, Scenario::SINGLE_HIT);
+BENCHMARK_CAPTURE(bm_analyser_tick, natural_string, Scenario::NATURAL_STRING);
+BENCHMARK_CAPTURE(bm_analyser_tick, multi_hit, Scenario::MULTI_HIT);
+
+} // namespace
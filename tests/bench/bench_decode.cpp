@@ -0,0 +1,128 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <cstring>
+
+#include "bulk_decode.h"
+#include "number_conversions.h"
+
+// Big-endian words decoded per iteration, a game frame has 24
+#define DECODE_WORDS 24
+// Game frame values, 24 words and the two 2-byte connection flags
+#define GAME_FRAME_VALUES 26
+
+namespace {
+
+void fill_words(char *buffer) {
+    for (int i = 0; i < DECODE_WORDS; i++) {
+        const float value = (float) i * 1.5F;
+        uint32_t bits = 0;
+        memcpy(&bits, &value, sizeof(bits)); // NOLINT
+        bits = __builtin_bswap32(bits);
+        memcpy(&buffer[i * 4], &bits, sizeof(bits)); // NOLINT
+    }
+}
+
+void bm_big32_to_little(benchmark::State &state) {
+    char buffer[DECODE_WORDS * 4];
+    fill_words(buffer);
+
+    for (auto _ : state) {
+        for (int i = 0; i < DECODE_WORDS; i++) {
+            benchmark::DoNotOptimize(big32_to_little(&buffer[i * 4])); // NOLINT
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * DECODE_WORDS);
+}
+BENCHMARK(bm_big32_to_little);
+
+void bm_big32_to_little_float(benchmark::State &state) {
+    char buffer[DECODE_WORDS * 4];
+    fill_words(buffer);
+
+    for (auto _ : state) {
+        for (int i = 0; i < DECODE_WORDS; i++) {
+            benchmark::DoNotOptimize(big32_to_little_float(&buffer[i * 4])); // NOLINT
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * DECODE_WORDS);
+}
+BENCHMARK(bm_big32_to_little_float);
+
+void init_game_frame(BulkDecodeLayout *layout, uint8_t *snapshot) {
+    uint8_t widths[GAME_FRAME_VALUES];
+    for (int i = 0; i < GAME_FRAME_VALUES; i++) {
+        widths[i] = 4;
+    }
+    // Connection flags follow the frames since last action of each player
+    widths[2] = 2;
+    widths[15] = 2;
+    (void) bulk_decode_layout_init(layout, widths, GAME_FRAME_VALUES);
+
+    for (uint32_t i = 0; i < layout->size; i++) {
+        snapshot[i] = (uint8_t) i;
+    }
+}
+
+// One call per field, as read_game_state did before the bulk decoder
+void bm_game_frame_per_field(benchmark::State &state) {
+    BulkDecodeLayout layout{};
+    uint8_t snapshot[BULK_DECODE_MAX_SIZE];
+    init_game_frame(&layout, snapshot);
+    const char *raw = (const char *) snapshot;
+
+    for (auto _ : state) {
+        for (uint32_t i = 0; i < layout.field_count; i++) {
+            if (layout.widths[i] == 2) {
+                benchmark::DoNotOptimize(big16_to_little(&raw[layout.offsets[i]])); // NOLINT
+            } else {
+                benchmark::DoNotOptimize(big32_to_little(&raw[layout.offsets[i]])); // NOLINT
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(bm_game_frame_per_field);
+
+void bm_game_frame_bulk(benchmark::State &state) {
+    const auto kernel = (BulkDecodeKernel) state.range(0);
+    const BulkDecodeKernel selected = bulk_decode_kernel();
+    if (bulk_decode_set_kernel(kernel) != 0) {
+        state.SkipWithError("kernel not supported by the CPU");
+        return;
+    }
+    state.SetLabel(bulk_decode_kernel_name(kernel));
+
+    BulkDecodeLayout layout{};
+    uint8_t snapshot[BULK_DECODE_MAX_SIZE];
+    uint8_t decoded[BULK_DECODE_MAX_SIZE];
+    init_game_frame(&layout, snapshot);
+
+    for (auto _ : state) {
+        bulk_decode(&layout, decoded, snapshot);
+        benchmark::DoNotOptimize(decoded);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+    (void) bulk_decode_set_kernel(selected);
+}
+BENCHMARK(bm_game_frame_bulk)->DenseRange(BULK_DECODE_SCALAR, BULK_DECODE_AVX2);
+
+} // namespace
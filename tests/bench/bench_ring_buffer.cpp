@@ -0,0 +1,72 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <benchmark/benchmark.h>
+
+#include "game_state_reader.h"
+#include "ring_buffer.hpp"
+
+// Same as the analyser's frame history
+#define HISTORY_SIZE 600
+
+namespace {
+
+void fill(RingBuffer<GameFrame> &buffer) {
+    GameFrame frame{};
+    for (uint32_t i = 0; i < buffer.capacity(); i++) {
+        frame.game_frame = i;
+        buffer.push(frame);
+    }
+}
+
+void bm_ring_buffer_push(benchmark::State &state) {
+    RingBuffer<GameFrame> buffer(HISTORY_SIZE);
+    GameFrame frame{};
+
+    for (auto _ : state) {
+        frame.game_frame++;
+        buffer.push(frame);
+        benchmark::DoNotOptimize(buffer.head());
+    }
+}
+BENCHMARK(bm_ring_buffer_push);
+
+void bm_ring_buffer_get_from_head(benchmark::State &state) {
+    RingBuffer<GameFrame> buffer(HISTORY_SIZE);
+    fill(buffer);
+    size_t index = 0;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(buffer.get_from_head(index));
+        index = (index + 1) % HISTORY_SIZE;
+    }
+}
+BENCHMARK(bm_ring_buffer_get_from_head);
+
+void bm_ring_buffer_get(benchmark::State &state) {
+    RingBuffer<GameFrame> buffer(HISTORY_SIZE);
+    fill(buffer);
+    size_t index = 0;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(buffer.get(index));
+        index = (index + 1) % HISTORY_SIZE;
+    }
+}
+BENCHMARK(bm_ring_buffer_get);
+
+} // namespace
@@ -0,0 +1,148 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef SYNTHETIC_FRAMES_HPP
+#define SYNTHETIC_FRAMES_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "frame_data_analyser.hpp"
+#include "game_state_reader.h"
+
+// Every scenario is a single P1 attack repeated once per second
+#define SCENARIO_PERIOD 60
+#define SCENARIO_FIRST_FRAME 1000
+
+enum class Scenario : uint8_t {
+    SINGLE_HIT,
+    NATURAL_STRING,
+    MULTI_HIT
+};
+
+struct ScenarioHit {
+    // Frame of the round on which the attack starts
+    int32_t start;
+    // Frame of the round on which the attack connects
+    int32_t connection;
+    // Attacker recovery when the attack starts
+    int32_t recovery = 30;
+    // Defender recovery when the attack connects
+    int32_t hit_stun = 20;
+};
+
+/**
+ * Attacks of a scenario, multi-hits share a single string ending
+ */
+inline std::vector<ScenarioHit> scenario_hits(const Scenario scenario) {
+    switch (scenario) {
+    case Scenario::SINGLE_HIT:
+        return {{.start = 10, .connection = 22}};
+    case Scenario::NATURAL_STRING:
+        return {{.start = 10, .connection = 22}, {.start = 25, .connection = 37}};
+    case Scenario::MULTI_HIT:
+        return {{.start = 10, .connection = 22}, {.start = 24, .connection = 26}, {.start = 28, .connection = 30}};
+    }
+    return {};
+}
+
+/**
+ * One round of side flipped game frames of the scenario with custom attacks
+ *
+ * @param scenario scenario
+ * @param hits attacks of the round, connections in order and before SCENARIO_PERIOD - 8
+ * @return SCENARIO_PERIOD frames
+ */
+inline std::vector<GameFrame> scenario_frames(const Scenario scenario, const std::vector<ScenarioHit> &hits) {
+    const bool is_string = scenario != Scenario::SINGLE_HIT;
+    const int32_t end = hits.back().connection + 8;
+
+    std::vector<GameFrame> frames(SCENARIO_PERIOD);
+    for (int32_t t = 0; t < SCENARIO_PERIOD; t++) {
+        GameFrame &frame = frames[t];
+        frame.game_frame = SCENARIO_FIRST_FRAME + t;
+
+        PlayerFrame &p1 = frame.p1;
+        PlayerFrame &p2 = frame.p2;
+        p1.state = (int32_t) PlayerState::STANDING;
+        p2.state = (int32_t) PlayerState::STANDING;
+        p2.position = {.x = 2500.0F, .y = 0, .z = 0};
+
+        for (const ScenarioHit &hit : hits) {
+            if (t >= hit.start) {
+                // Sequence number changes when each attack starts
+                p1.attack_seq++;
+                p1.intent = (int32_t) PlayerIntent::ATTACK1;
+                p1.move = 1;
+                p1.recovery_frames = hit.recovery - (t - hit.start);
+            }
+            if (t == hit.connection) {
+                p1.connection = 1;
+            }
+            if (t >= hit.connection) {
+                p2.state = (int32_t) PlayerState::STANDING_HIT;
+                p2.recovery_frames = hit.hit_stun - (t - hit.connection);
+            }
+        }
+
+        if (t >= end) {
+            p1 = {};
+            p1.state = (int32_t) PlayerState::STANDING;
+            p1.attack_seq = (int32_t) hits.size();
+            p2.state = (int32_t) PlayerState::STANDING;
+            p2.recovery_frames = 0;
+        } else if (is_string && t >= hits.front().start) {
+            p1.state = (int32_t) PlayerState::STRING;
+            if (scenario == Scenario::MULTI_HIT && t > hits.front().start) {
+                p1.string_type = (int32_t) StringType::MULTIHIT0;
+            }
+            if (t >= hits.back().connection + 2) {
+                p1.string_state = (int32_t) StringState::ENDED;
+            }
+        }
+    }
+
+    return frames;
+}
+
+/**
+ * One round of side flipped game frames of the scenario
+ *
+ * @param scenario scenario
+ * @return SCENARIO_PERIOD frames
+ */
+inline std::vector<GameFrame> scenario_frames(const Scenario scenario) {
+    return scenario_frames(scenario, scenario_hits(scenario));
+}
+
+/**
+ * Frame of a repeated scenario round with increasing frame and sequence numbers
+ *
+ * @param round_frames frames of one round
+ * @param hits attacks per round
+ * @param index frame index from the start
+ * @return game frame
+ */
+inline GameFrame scenario_frame(const std::vector<GameFrame> &round_frames, const size_t hits, const size_t index) {
+    const size_t round = index / round_frames.size();
+    GameFrame frame = round_frames[index % round_frames.size()];
+    frame.game_frame = SCENARIO_FIRST_FRAME + (uint32_t) index;
+    frame.p1.attack_seq += (int32_t) (round * hits);
+    return frame;
+}
+
+#endif
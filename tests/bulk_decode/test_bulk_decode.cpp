@@ -0,0 +1,193 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <random>
+
+#include "bulk_decode.h"
+
+namespace {
+
+// Game frame width map, 2-byte connection flags and 3 coordinates per player
+const uint8_t GAME_FRAME_WIDTHS[] = {4, 4, 2, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 2, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4};
+
+// Restores the runtime selected kernel after each test
+class test_bulk_decode_kernels : public ::testing::Test {
+protected:
+    void SetUp() override {
+        m_kernel = bulk_decode_kernel();
+    }
+
+    void TearDown() override {
+        ASSERT_EQ(bulk_decode_set_kernel(m_kernel), 0);
+    }
+
+private:
+    BulkDecodeKernel m_kernel = BULK_DECODE_SCALAR;
+};
+
+} // namespace
+
+TEST(test_bulk_decode, layout_aligns_fields) {
+    BulkDecodeLayout layout{};
+    const uint8_t widths[] = {1, 4, 2, 8, 1};
+    ASSERT_EQ(bulk_decode_layout_init(&layout, widths, 5), 0);
+
+    EXPECT_EQ(layout.field_count, 5);
+    EXPECT_EQ(layout.offsets[0], 0);
+    EXPECT_EQ(layout.offsets[1], 4);
+    EXPECT_EQ(layout.offsets[2], 8);
+    EXPECT_EQ(layout.offsets[3], 16);
+    EXPECT_EQ(layout.offsets[4], 24);
+    EXPECT_EQ(layout.size, 25);
+}
+
+TEST(test_bulk_decode, layout_rejects_invalid_fields) {
+    BulkDecodeLayout layout{};
+    const uint8_t odd_width[] = {4, 3};
+    EXPECT_EQ(bulk_decode_layout_init(&layout, odd_width, 2), -1);
+
+    const uint8_t zero_width[] = {0};
+    EXPECT_EQ(bulk_decode_layout_init(&layout, zero_width, 1), -1);
+
+    uint8_t widths[BULK_DECODE_MAX_FIELDS + 1];
+    memset(widths, 8, sizeof(widths));
+    EXPECT_EQ(bulk_decode_layout_init(&layout, widths, BULK_DECODE_MAX_FIELDS + 1), -1);
+    // 64 fields of 8 bytes exceed the size limit
+    EXPECT_EQ(bulk_decode_layout_init(&layout, widths, BULK_DECODE_MAX_FIELDS), -1);
+}
+
+TEST_F(test_bulk_decode_kernels, decodes_values) {
+    BulkDecodeLayout layout{};
+    const uint8_t widths[] = {4, 2, 4, 8, 1};
+    ASSERT_EQ(bulk_decode_layout_init(&layout, widths, 5), 0);
+
+    // Big-endian guest memory
+    uint8_t big_endian[BULK_DECODE_MAX_SIZE] = {};
+    const uint8_t int_bytes[] = {0xFF, 0xFF, 0xFF, 0xF6};
+    const uint8_t short_bytes[] = {0x01, 0x02};
+    const uint8_t float_bytes[] = {0x40, 0x20, 0x00, 0x00};
+    const uint8_t long_bytes[] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+    memcpy(&big_endian[layout.offsets[0]], int_bytes, sizeof(int_bytes));
+    memcpy(&big_endian[layout.offsets[1]], short_bytes, sizeof(short_bytes));
+    memcpy(&big_endian[layout.offsets[2]], float_bytes, sizeof(float_bytes));
+    memcpy(&big_endian[layout.offsets[3]], long_bytes, sizeof(long_bytes));
+    big_endian[layout.offsets[4]] = 0x7F;
+
+    for (int kernel = 0; kernel < BULK_DECODE_KERNELS; kernel++) {
+        if (bulk_decode_set_kernel((BulkDecodeKernel) kernel) != 0) {
+            continue;
+        }
+        SCOPED_TRACE(bulk_decode_kernel_name((BulkDecodeKernel) kernel));
+
+        uint8_t decoded[BULK_DECODE_MAX_SIZE] = {};
+        bulk_decode(&layout, decoded, big_endian);
+
+        int32_t int_value = 0;
+        int16_t short_value = 0;
+        float float_value = 0;
+        uint64_t long_value = 0;
+        memcpy(&int_value, &decoded[layout.offsets[0]], sizeof(int_value));
+        memcpy(&short_value, &decoded[layout.offsets[1]], sizeof(short_value));
+        memcpy(&float_value, &decoded[layout.offsets[2]], sizeof(float_value));
+        memcpy(&long_value, &decoded[layout.offsets[3]], sizeof(long_value));
+
+        EXPECT_EQ(int_value, -10);
+        EXPECT_EQ(short_value, 0x0102);
+        EXPECT_FLOAT_EQ(float_value, 2.5F);
+        EXPECT_EQ(long_value, 0x0102030405060708ULL);
+        EXPECT_EQ(decoded[layout.offsets[4]], 0x7F);
+    }
+}
+
+TEST_F(test_bulk_decode_kernels, kernels_match_scalar) {
+    std::mt19937 random(1234); // NOLINT
+    std::uniform_int_distribution<int> width_exponent(0, 3);
+    std::uniform_int_distribution<int> byte(0, 255);
+
+    for (int round = 0; round < 200; round++) {
+        // Field counts from empty up to sizes with every tail length
+        uint8_t widths[BULK_DECODE_MAX_FIELDS];
+        const uint32_t count = round % 40;
+        for (uint32_t i = 0; i < count; i++) {
+            widths[i] = (uint8_t) (1U << width_exponent(random));
+        }
+
+        BulkDecodeLayout layout{};
+        ASSERT_EQ(bulk_decode_layout_init(&layout, widths, count), 0);
+
+        uint8_t source[BULK_DECODE_MAX_SIZE];
+        for (uint8_t &value : source) {
+            value = (uint8_t) byte(random);
+        }
+
+        uint8_t expected[BULK_DECODE_MAX_SIZE];
+        memcpy(expected, source, sizeof(expected));
+        ASSERT_EQ(bulk_decode_set_kernel(BULK_DECODE_SCALAR), 0);
+        bulk_decode(&layout, expected, source);
+
+        for (int kernel = BULK_DECODE_SSSE3; kernel < BULK_DECODE_KERNELS; kernel++) {
+            if (bulk_decode_set_kernel((BulkDecodeKernel) kernel) != 0) {
+                continue;
+            }
+            SCOPED_TRACE(bulk_decode_kernel_name((BulkDecodeKernel) kernel));
+
+            // Bytes past the snapshot are left untouched
+            uint8_t decoded[BULK_DECODE_MAX_SIZE];
+            memcpy(decoded, source, sizeof(decoded));
+            bulk_decode(&layout, decoded, source);
+            ASSERT_EQ(memcmp(decoded, expected, sizeof(decoded)), 0) << "round " << round;
+
+            uint8_t in_place[BULK_DECODE_MAX_SIZE];
+            memcpy(in_place, source, sizeof(in_place));
+            bulk_decode(&layout, in_place, in_place);
+            ASSERT_EQ(memcmp(in_place, expected, sizeof(in_place)), 0) << "round " << round;
+        }
+    }
+}
+
+TEST_F(test_bulk_decode_kernels, game_frame_round_trip) {
+    BulkDecodeLayout layout{};
+    const uint32_t count = sizeof(GAME_FRAME_WIDTHS);
+    ASSERT_EQ(bulk_decode_layout_init(&layout, GAME_FRAME_WIDTHS, count), 0);
+    EXPECT_EQ(layout.size, 100);
+
+    uint8_t snapshot[BULK_DECODE_MAX_SIZE] = {};
+    for (uint32_t i = 0; i < count; i++) {
+        snapshot[layout.offsets[i]] = (uint8_t) (i + 1);
+    }
+
+    for (int kernel = 0; kernel < BULK_DECODE_KERNELS; kernel++) {
+        if (bulk_decode_set_kernel((BulkDecodeKernel) kernel) != 0) {
+            continue;
+        }
+        SCOPED_TRACE(bulk_decode_kernel_name((BulkDecodeKernel) kernel));
+
+        // Decoding twice restores the big-endian snapshot
+        uint8_t decoded[BULK_DECODE_MAX_SIZE] = {};
+        bulk_decode(&layout, decoded, snapshot);
+        for (uint32_t i = 0; i < count; i++) {
+            EXPECT_EQ(decoded[layout.offsets[i] + layout.widths[i] - 1], i + 1);
+        }
+
+        bulk_decode(&layout, decoded, decoded);
+        EXPECT_EQ(memcmp(decoded, snapshot, layout.size), 0);
+    }
+}
@@ -0,0 +1,205 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "event_server.hpp"
+
+#define TIMEOUT_MS 2000
+
+namespace {
+
+// Per process, tests run in parallel
+const std::string SOCKET_PATH = "/tmp/t6_test_event_server_" + std::to_string(getpid()) + ".sock";
+
+int connect_client() {
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, SOCKET_PATH.c_str()); // NOLINT
+    if (connect(fd, (const sockaddr *) &address, sizeof(address)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+bool wait_for_clients(const size_t count) {
+    for (int i = 0; i < TIMEOUT_MS; i++) {
+        if (EventServer::client_count() == count) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+}
+
+/**
+ * Read one line, empty if nothing arrives before the timeout
+ */
+std::string read_line(const int fd, const int timeout_ms = TIMEOUT_MS) {
+    std::string line;
+    char c = 0;
+    pollfd pfd = {.fd = fd, .events = POLLIN, .revents = 0};
+    while (poll(&pfd, 1, timeout_ms) > 0 && read(fd, &c, 1) == 1) {
+        if (c == '\n') {
+            return line;
+        }
+        line += c;
+    }
+    return line;
+}
+
+void send_command(const int fd, const char *command) {
+    ASSERT_EQ((ssize_t) strlen(command), write(fd, command, strlen(command)));
+}
+
+TickEvents frame_data_events() {
+    TickEvents events{};
+    events.changed = TICK_FRAME_DATA | TICK_DISTANCE;
+    events.frame_data = {.startup_frames = 13, .frame_advantage = -4, .knock_down = true};
+    events.distance = 2.5F;
+    return events;
+}
+
+// Stops the server thread and closes the client even when an assertion fails
+class test_event_server : public ::testing::Test {
+protected:
+    int m_fd = -1;
+
+    void TearDown() override {
+        if (m_fd >= 0) {
+            close(m_fd);
+        }
+        EventServer::stop();
+        (void) unlink(SOCKET_PATH.c_str());
+    }
+};
+
+} // namespace
+
+TEST_F(test_event_server, stream_events) {
+    ASSERT_TRUE(EventServer::start(SOCKET_PATH.c_str()));
+    m_fd = connect_client();
+    ASSERT_GE(m_fd, 0);
+    ASSERT_TRUE(wait_for_clients(1));
+
+    EventServer::publish(frame_data_events());
+    ASSERT_EQ("{\"event\":\"frame_data\",\"startup_frames\":13,\"frame_advantage\":-4,\"knock_down\":true}",
+              read_line(m_fd));
+    ASSERT_EQ("{\"event\":\"distance\",\"distance\":2.500}", read_line(m_fd));
+
+    TickEvents events{};
+    events.changed = TICK_HOOK | TICK_RESYNC;
+    events.hooked = true;
+    events.frames_off = 3;
+    EventServer::publish(events);
+    ASSERT_EQ("{\"event\":\"hook\",\"hooked\":true}", read_line(m_fd));
+    ASSERT_EQ("{\"event\":\"resync\",\"frames_off\":3}", read_line(m_fd));
+
+    close(m_fd);
+    m_fd = -1;
+    ASSERT_TRUE(wait_for_clients(0));
+}
+
+TEST_F(test_event_server, subscriptions) {
+    ASSERT_TRUE(EventServer::start(SOCKET_PATH.c_str()));
+    m_fd = connect_client();
+    ASSERT_GE(m_fd, 0);
+    ASSERT_TRUE(wait_for_clients(1));
+
+    send_command(m_fd, "unsubscribe all\nsubscribe distance\n");
+    send_command(m_fd, "subscribe nothing\n");
+    ASSERT_EQ("{\"event\":\"error\",\"message\":\"unknown event type\"}", read_line(m_fd));
+
+    EventServer::publish(frame_data_events());
+    ASSERT_EQ("{\"event\":\"distance\",\"distance\":2.500}", read_line(m_fd));
+    ASSERT_EQ("", read_line(m_fd, 100));
+
+    close(m_fd);
+    m_fd = -1;
+    ASSERT_TRUE(wait_for_clients(0));
+}
+
+TEST_F(test_event_server, drop_slow_client) {
+    ASSERT_TRUE(EventServer::start(SOCKET_PATH.c_str()));
+    m_fd = connect_client();
+    ASSERT_GE(m_fd, 0);
+    ASSERT_TRUE(wait_for_clients(1));
+
+    // Never read, the client is dropped once its buffer and the socket are full
+    for (int i = 0; i < 100000 && EventServer::client_count() > 0; i++) {
+        EventServer::publish(frame_data_events());
+        if (i % 256 == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    ASSERT_TRUE(wait_for_clients(0));
+}
+
+TEST_F(test_event_server, late_client_gets_latest_values) {
+    ASSERT_TRUE(EventServer::start(SOCKET_PATH.c_str()));
+
+    // Published without clients
+    TickEvents events{};
+    events.changed = TICK_HOOK | TICK_STATUS | TICK_RESYNC;
+    events.hooked = true;
+    events.status = PlayerState::STANDING;
+    events.frames_off = 2;
+    EventServer::publish(events);
+    EventServer::publish(frame_data_events());
+
+    m_fd = connect_client();
+    ASSERT_GE(m_fd, 0);
+    ASSERT_EQ("{\"event\":\"frame_data\",\"startup_frames\":13,\"frame_advantage\":-4,\"knock_down\":true}",
+              read_line(m_fd));
+    ASSERT_EQ("{\"event\":\"distance\",\"distance\":2.500}", read_line(m_fd));
+    ASSERT_EQ(0, read_line(m_fd).rfind("{\"event\":\"status\"", 0));
+    ASSERT_EQ("{\"event\":\"hook\",\"hooked\":true}", read_line(m_fd));
+    ASSERT_TRUE(wait_for_clients(1));
+
+    // Then changes only
+    events = {};
+    events.changed = TICK_DISTANCE;
+    events.distance = 1.0F;
+    EventServer::publish(events);
+    ASSERT_EQ("{\"event\":\"distance\",\"distance\":1.000}", read_line(m_fd));
+    ASSERT_EQ("", read_line(m_fd, 100));
+}
+
+TEST_F(test_event_server, never_replaces_other_files) {
+    const int file = open(SOCKET_PATH.c_str(), O_CREAT | O_WRONLY | O_TRUNC, 0600); // NOLINT
+    ASSERT_GE(file, 0);
+    close(file);
+
+    ASSERT_FALSE(EventServer::start(SOCKET_PATH.c_str()));
+    struct stat status = {};
+    ASSERT_EQ(0, lstat(SOCKET_PATH.c_str(), &status));
+    ASSERT_TRUE(S_ISREG(status.st_mode));
+}
@@ -0,0 +1,98 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef FAKE_EMULATOR_HPP
+#define FAKE_EMULATOR_HPP
+
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "memory_reader.h"
+
+#include "fake_script.hpp"
+
+/**
+ * Fake emulator child process, terminated when destroyed
+ *
+ * The memory reader attaches to this process while it exists, so tests
+ * running in parallel never read each other's emulator.
+ */
+class FakeEmulator {
+public:
+    /**
+     * Start the fake emulator and wait until it has written the first frame
+     *
+     * @param hz frames per second, "0" holds the first frame
+     * @param side player side, "left" or "right"
+     */
+    FakeEmulator(const char *hz, const char *side) {
+        int fds[2];
+        if (pipe(fds) != 0) {
+            return;
+        }
+
+        m_pid = fork();
+        if (m_pid == 0) {
+            dup2(fds[1], STDOUT_FILENO);
+            close(fds[0]);
+            close(fds[1]);
+            execl(FAKE_RPCS3_PATH, FAKE_RPCS3_PATH, "--hz", hz, "--side", side, nullptr);
+            _exit(127);
+        }
+        close(fds[1]);
+
+        char line[16] = {};
+        FILE *output = fdopen(fds[0], "r");
+        m_ready = fgets(line, sizeof(line), output) != nullptr && strcmp(line, "ready\n") == 0;
+        (void) fclose(output);
+
+        if (m_pid > 0) {
+            set_emulator_pid(m_pid);
+        }
+    }
+
+    ~FakeEmulator() {
+        if (m_pid > 0) {
+            set_emulator_pid(-1);
+            kill(m_pid, SIGTERM);
+            waitpid(m_pid, nullptr, 0);
+        }
+    }
+
+    FakeEmulator(const FakeEmulator &) = delete;
+    FakeEmulator(FakeEmulator &&) = delete;
+    FakeEmulator &operator=(const FakeEmulator &) = delete;
+    FakeEmulator &operator=(FakeEmulator &&) = delete;
+
+    [[nodiscard]] bool ready() const {
+        return m_ready;
+    }
+
+    [[nodiscard]] pid_t pid() const {
+        return m_pid;
+    }
+
+private:
+    pid_t m_pid = -1;
+    bool m_ready = false;
+};
+
+#endif
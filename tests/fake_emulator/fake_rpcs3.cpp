@@ -0,0 +1,273 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+// Stand-in for the emulator process in reader integration tests and benchmarks
+//
+// Maps guest memory at the addresses of address_config.h and writes big-endian
+// game frames to it at the game's frame rate. Like the emulator, guest memory
+// is a shared memory object which other processes can map too. The memory reader finds it by the
+// "rpcs3" in its name.
+//
+// Usage: fake_rpcs3 [--hz N] [--frames N] [--side left|right] [--trace FILE]
+//
+//   --hz N        frames per second, 0 writes the first frame and holds it (60)
+//   --frames N    exit after N frames, 0 runs until terminated (0)
+//   --side SIDE   player side of P1 (left)
+//   --trace FILE  replay a frame trace instead of the built-in script
+//
+// Prints "ready" once the first frame is written.
+
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <unistd.h>
+
+#include "address_config.h"
+#include "frame_trace.hpp"
+#include "number_conversions.h"
+
+#include "fake_script.hpp"
+
+// Constants
+#define DEFAULT_HZ 60
+// Guest addresses the pointer chains point to
+#define PLAYER_SIDE_TARGET 0x10000000
+#define P1_ATTACK_SEQ_TARGET 0x10001000
+#define P2_ATTACK_SEQ_TARGET 0x10002000
+
+namespace {
+
+struct Options {
+    int hz;
+    long frames;
+    PlayerSide side;
+    const char *trace_file;
+};
+
+volatile sig_atomic_t g_stop = 0;
+
+void handle_signal(int /*signal*/) {
+    g_stop = 1;
+}
+
+void write_big32(const uint64_t address, const uint32_t value) {
+    const uint32_t big = __builtin_bswap32(value);
+    memcpy((void *) address, &big, sizeof(big)); // NOLINT
+}
+
+void write_big16(const uint64_t address, const uint16_t value) {
+    const uint16_t big = __builtin_bswap16(value);
+    memcpy((void *) address, &big, sizeof(big)); // NOLINT
+}
+
+void write_big_float(const uint64_t address, const float value) {
+    uint32_t bits = 0;
+    memcpy(&bits, &value, sizeof(bits)); // NOLINT
+    write_big32(address, bits);
+}
+
+void write_position(const uint64_t address, const PlayerCoordinate &position) {
+    write_big_float(address, position.x);
+    write_big_float(address + 4, position.y);
+    write_big_float(address + 8, position.z);
+}
+
+/**
+ * Point the pointer at "pointer" to "target" so that reading it and adding
+ * "offset" resolves to the target
+ */
+void write_pointer_chain(const uint64_t pointer, const uint32_t target, const uint32_t offset) {
+    write_big32(pointer, target - offset);
+}
+
+void write_frame(const GameFrame &frame, const PlayerSide side) {
+    // Raw memory holds the players before side flipping
+    const PlayerFrame &p1 = side == PlayerSide::LEFT ? frame.p1 : frame.p2;
+    const PlayerFrame &p2 = side == PlayerSide::LEFT ? frame.p2 : frame.p1;
+
+    write_big32(P1_FRAMES_LAST_ACTION, p1.frames_last_action);
+    write_big32(P1_RECOVERY_FRAMES, p1.recovery_frames);
+    write_big16(P1_CONNECTION_BOOL, p1.connection);
+    write_big32(P1_INTENT, p1.intent);
+    write_big32(P1_MOVE, p1.move);
+    write_big32(P1_STATE, p1.state);
+    write_big32(P1_STRING_TYPE, p1.string_type);
+    write_big32(P1_STRING_STATE, p1.string_state);
+    write_position(P1_POSITION, p1.position);
+    write_big32(ps3_address_to_x64(P1_ATTACK_SEQ_TARGET), p1.attack_seq);
+
+    write_big32(P2_FRAMES_LAST_ACTION, p2.frames_last_action);
+    write_big32(P2_RECOVERY_FRAMES, p2.recovery_frames);
+    write_big16(P2_CONNECTION_BOOL, p2.connection);
+    write_big32(P2_INTENT, p2.intent);
+    write_big32(P2_MOVE, p2.move);
+    write_big32(P2_STATE, p2.state);
+    write_big32(P2_STRING_TYPE, p2.string_type);
+    write_big32(P2_STRING_STATE, p2.string_state);
+    write_position(P2_POSITION, p2.position);
+    write_big32(ps3_address_to_x64(P2_ATTACK_SEQ_TARGET), p2.attack_seq);
+
+    // Frame number last, readers start from it
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    write_big32(CURRENT_GAME_FRAME, frame.game_frame);
+}
+
+bool map_guest_memory() {
+    // Kept open for the lifetime of the process, readers find it in /proc/PID/fd
+    const int fd = memfd_create(FAKE_GUEST_MEMORY_NAME, MFD_CLOEXEC);
+    if (fd < 0 || ftruncate(fd, FAKE_GUEST_MEMORY_SIZE) != 0) {
+        (void) fprintf(stderr, "failed to create guest memory\n");
+        return false;
+    }
+
+    void *memory = mmap((void *) FAKE_GUEST_MEMORY_BASE, // NOLINT
+                        FAKE_GUEST_MEMORY_SIZE,
+                        PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_NORESERVE | MAP_FIXED_NOREPLACE,
+                        fd,
+                        0);
+    if (memory != (void *) FAKE_GUEST_MEMORY_BASE) { // NOLINT
+        (void) fprintf(stderr, "failed to map guest memory at 0x%llx\n", (unsigned long long) FAKE_GUEST_MEMORY_BASE);
+        return false;
+    }
+
+    write_pointer_chain(PLAYER_SIDE_PTR, PLAYER_SIDE_TARGET, PLAYER_SIDE_OFFSET);
+    write_pointer_chain(P1_ATTACK_SEQ_PTR, P1_ATTACK_SEQ_TARGET, P1_ATTACK_SEQ_OFFSET);
+    write_pointer_chain(P2_ATTACK_SEQ_PTR, P2_ATTACK_SEQ_TARGET, P2_ATTACK_SEQ_OFFSET);
+    return true;
+}
+
+bool load_trace(const char *path, std::vector<GameFrame> *frames) {
+    FILE *file = fopen(path, "rb");
+    if (file == nullptr) {
+        (void) fprintf(stderr, "failed to open trace file %s\n", path);
+        return false;
+    }
+
+    if (!FrameTrace::read_header(file)) {
+        (void) fclose(file);
+        return false;
+    }
+
+    GameFrame frame{};
+    while (fread(&frame, sizeof(frame), 1, file) == 1) {
+        frames->push_back(frame);
+    }
+    (void) fclose(file);
+
+    if (frames->empty()) {
+        (void) fprintf(stderr, "trace file %s has no frames\n", path);
+        return false;
+    }
+    return true;
+}
+
+bool parse_options(const int argc, const char **argv, Options *options) {
+    *options = {.hz = DEFAULT_HZ, .frames = 0, .side = PlayerSide::LEFT, .trace_file = nullptr};
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i]; // NOLINT
+        if (i + 1 == argc) {
+            return false;
+        }
+        const char *value = argv[++i]; // NOLINT
+
+        if (strcmp(arg, "--hz") == 0) {
+            options->hz = atoi(value); // NOLINT
+        } else if (strcmp(arg, "--frames") == 0) {
+            options->frames = atol(value); // NOLINT
+        } else if (strcmp(arg, "--side") == 0 && strcmp(value, "left") == 0) {
+            options->side = PlayerSide::LEFT;
+        } else if (strcmp(arg, "--side") == 0 && strcmp(value, "right") == 0) {
+            options->side = PlayerSide::RIGHT;
+        } else if (strcmp(arg, "--trace") == 0) {
+            options->trace_file = value;
+        } else {
+            return false;
+        }
+    }
+    return options->hz >= 0 && options->frames >= 0;
+}
+
+} // namespace
+
+int main(const int argc, const char **argv) {
+    Options options{};
+    if (!parse_options(argc, argv, &options)) {
+        (void) fprintf(stderr,
+                       "usage: %s [--hz N] [--frames N] [--side left|right] [--trace FILE]\n",
+                       argv[0]); // NOLINT
+        return 1;
+    }
+
+    std::vector<GameFrame> trace;
+    if (options.trace_file != nullptr && !load_trace(options.trace_file, &trace)) {
+        return 1;
+    }
+
+    if (!map_guest_memory()) {
+        return 1;
+    }
+
+    // Let readers which are not our parent attach under Yama ptrace scope 1
+    (void) prctl(PR_SET_PTRACER, PR_SET_PTRACER_ANY);
+    (void) signal(SIGTERM, &handle_signal);
+    (void) signal(SIGINT, &handle_signal);
+
+    write_big32(ps3_address_to_x64(PLAYER_SIDE_TARGET), (uint32_t) options.side);
+
+    const auto frame_length = std::chrono::nanoseconds(options.hz > 0 ? 1000000000 / options.hz : 0);
+    auto next_frame = std::chrono::steady_clock::now();
+
+    for (long index = 0; g_stop == 0 && (options.frames == 0 || index < options.frames); index++) {
+        GameFrame frame{};
+        if (trace.empty()) {
+            frame = fake_script_frame((uint32_t) index);
+        } else {
+            // Keep the frame number increasing when the trace loops
+            frame = trace[index % trace.size()];
+            frame.game_frame = trace[0].game_frame + (uint32_t) index;
+        }
+        write_frame(frame, options.side);
+
+        if (index == 0) {
+            (void) printf("ready\n");
+            (void) fflush(stdout);
+        }
+
+        if (options.hz == 0) {
+            // Hold the first frame
+            while (g_stop == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+            break;
+        }
+
+        next_frame += frame_length;
+        std::this_thread::sleep_until(next_frame);
+    }
+
+    return 0;
+}
@@ -0,0 +1,81 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef FAKE_SCRIPT_HPP
+#define FAKE_SCRIPT_HPP
+
+#include <cstdint>
+
+#include "frame_data_analyser.hpp"
+#include "game_state_reader.h"
+
+// Guest memory of the fake emulator, a memfd mapped at the PS3 address base
+#define FAKE_GUEST_MEMORY_BASE 0x300000000
+#define FAKE_GUEST_MEMORY_SIZE 0x40000000
+#define FAKE_GUEST_MEMORY_NAME "fake_rpcs3_guest"
+
+// Built-in script of the fake emulator, a single P1 hit repeated every second
+#define FAKE_SCRIPT_PERIOD 60
+#define FAKE_SCRIPT_FIRST_FRAME 1000
+#define FAKE_SCRIPT_ATTACK_FRAME 10
+#define FAKE_SCRIPT_STARTUP 12
+#define FAKE_SCRIPT_ATTACK_RECOVERY 30
+#define FAKE_SCRIPT_HIT_RECOVERY 20
+// Analyser result for the scripted hit, startup - (attack recovery - hit recovery)
+#define FAKE_SCRIPT_FRAME_ADVANTAGE 2
+#define FAKE_SCRIPT_P2_DISTANCE 2500.0F
+
+/**
+ * Game frame of the built-in script after player side flipping
+ *
+ * @param index frame index from the start of the script
+ * @return game frame
+ */
+inline GameFrame fake_script_frame(const uint32_t index) {
+    const auto t = (int32_t) (index % FAKE_SCRIPT_PERIOD);
+    const auto round = (int32_t) (index / FAKE_SCRIPT_PERIOD);
+    const int32_t attack = t - FAKE_SCRIPT_ATTACK_FRAME;
+    const int32_t hit = attack - FAKE_SCRIPT_STARTUP;
+
+    GameFrame frame{};
+    frame.game_frame = FAKE_SCRIPT_FIRST_FRAME + index;
+
+    frame.p1.frames_last_action = t;
+    frame.p1.state = (int32_t) PlayerState::STANDING;
+    frame.p1.intent = (int32_t) PlayerIntent::IDLE;
+    // Sequence number changes once per round when the attack starts
+    frame.p1.attack_seq = round + (attack >= 0 ? 1 : 0);
+    if (attack >= 0 && attack < FAKE_SCRIPT_ATTACK_RECOVERY) {
+        frame.p1.intent = (int32_t) PlayerIntent::ATTACK1;
+        frame.p1.move = 1;
+        frame.p1.recovery_frames = FAKE_SCRIPT_ATTACK_RECOVERY - attack;
+    }
+    frame.p1.connection = hit == 0 ? 1 : 0;
+
+    frame.p2.frames_last_action = t;
+    frame.p2.state = (int32_t) PlayerState::STANDING;
+    frame.p2.intent = (int32_t) PlayerIntent::IDLE;
+    if (hit >= 0 && hit < FAKE_SCRIPT_HIT_RECOVERY) {
+        frame.p2.state = (int32_t) PlayerState::STANDING_HIT;
+        frame.p2.recovery_frames = FAKE_SCRIPT_HIT_RECOVERY - hit;
+    }
+    frame.p2.position = {.x = FAKE_SCRIPT_P2_DISTANCE, .y = 0, .z = 0};
+
+    return frame;
+}
+
+#endif
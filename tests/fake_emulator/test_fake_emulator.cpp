@@ -0,0 +1,174 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#include "frame_data_analyser.hpp"
+#include "game_state_reader.h"
+#include "memory_reader.h"
+#include "memory_reader_types.h"
+#include "read_stats.h"
+
+#include "fake_emulator.hpp"
+
+#define ANALYSER_TIMEOUT_MS 5000
+
+namespace {
+
+const ReadStats *find_read_stats(const char *name) {
+    for (size_t i = 0; i < read_stats_count(); i++) {
+        const ReadStats *stats = read_stats_get(i);
+        if (stats->name != nullptr && strcmp(stats->name, name) == 0) {
+            return stats;
+        }
+    }
+    return nullptr;
+}
+
+void expect_player(const PlayerFrame &expected, const PlayerFrame &actual) {
+    EXPECT_EQ(expected.frames_last_action, actual.frames_last_action);
+    EXPECT_EQ(expected.recovery_frames, actual.recovery_frames);
+    EXPECT_EQ(expected.connection, actual.connection);
+    EXPECT_EQ(expected.intent, actual.intent);
+    EXPECT_EQ(expected.move, actual.move);
+    EXPECT_EQ(expected.state, actual.state);
+    EXPECT_EQ(expected.string_type, actual.string_type);
+    EXPECT_EQ(expected.string_state, actual.string_state);
+    EXPECT_FLOAT_EQ(expected.position.x, actual.position.x);
+    EXPECT_FLOAT_EQ(expected.position.y, actual.position.y);
+    EXPECT_FLOAT_EQ(expected.position.z, actual.position.z);
+    EXPECT_EQ(expected.attack_seq, actual.attack_seq);
+}
+
+class Listener : public EventListener {
+public:
+    std::atomic<bool> hooked = false;
+    std::atomic<bool> has_frame_data = false;
+    FrameDataPoint frame_data{};
+
+    void tick(const TickEvents &events) override {
+        if ((events.changed & TICK_HOOK) != 0) {
+            hooked = events.hooked;
+        }
+        if ((events.changed & TICK_FRAME_DATA) != 0 && !has_frame_data) {
+            frame_data = events.frame_data;
+            has_frame_data = true;
+            FrameDataAnalyser::stop();
+        }
+    }
+};
+
+} // namespace
+
+TEST(test_fake_emulator, read_game_state) {
+    const FakeEmulator emulator("0", "left");
+    ASSERT_TRUE(emulator.ready());
+    ASSERT_EQ(MR_INIT_OK, init_memory_reader());
+
+    GameFrame state{};
+    ASSERT_EQ(READ_OK, read_game_state(&state));
+
+    const GameFrame expected = fake_script_frame(0);
+    EXPECT_EQ(expected.game_frame, state.game_frame);
+    expect_player(expected.p1, state.p1);
+    expect_player(expected.p2, state.p2);
+
+    int32_t side = -1;
+    ASSERT_EQ(READ_OK, player_side(&side));
+    EXPECT_EQ((int32_t) PlayerSide::LEFT, side);
+}
+
+TEST(test_fake_emulator, right_side_swaps_players) {
+    const FakeEmulator emulator("0", "right");
+    ASSERT_TRUE(emulator.ready());
+    ASSERT_EQ(MR_INIT_OK, init_memory_reader());
+
+    GameFrame state{};
+    ASSERT_EQ(READ_OK, read_game_state(&state));
+
+    // Raw memory holds the players unflipped
+    const GameFrame expected = fake_script_frame(0);
+    expect_player(expected.p2, state.p1);
+    expect_player(expected.p1, state.p2);
+
+    int32_t side = -1;
+    ASSERT_EQ(READ_OK, player_side(&side));
+    EXPECT_EQ((int32_t) PlayerSide::RIGHT, side);
+}
+
+TEST(test_fake_emulator, analyser_single_hit) {
+    const FakeEmulator emulator("60", "right");
+    ASSERT_TRUE(emulator.ready());
+
+    Listener listener;
+    std::thread analyser([&listener]() { FrameDataAnalyser::start(&listener); });
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(ANALYSER_TIMEOUT_MS);
+    while (!listener.has_frame_data && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    FrameDataAnalyser::stop();
+    analyser.join();
+
+    ASSERT_TRUE(listener.hooked);
+    ASSERT_TRUE(listener.has_frame_data);
+    EXPECT_EQ(FAKE_SCRIPT_STARTUP, listener.frame_data.startup_frames);
+    EXPECT_EQ(FAKE_SCRIPT_FRAME_ADVANTAGE, listener.frame_data.frame_advantage);
+    EXPECT_FALSE(listener.frame_data.knock_down);
+}
+
+TEST(test_fake_emulator, read_stats) {
+    const FakeEmulator emulator("0", "left");
+    ASSERT_TRUE(emulator.ready());
+    read_stats_enable();
+    ASSERT_EQ(MR_INIT_OK, init_memory_reader());
+
+    GameFrame state{};
+    ASSERT_EQ(READ_OK, read_game_state(&state));
+    ASSERT_EQ(READ_OK, read_game_state(&state));
+
+    const ReadStats *p1_state = find_read_stats("p1 state");
+    ASSERT_NE(nullptr, p1_state);
+    EXPECT_EQ(4, p1_state->size);
+    EXPECT_EQ(2, latency_histogram_count(&p1_state->latency));
+    EXPECT_EQ(0, p1_state->errors);
+
+    const ReadStats *position = find_read_stats("p2 position");
+    ASSERT_NE(nullptr, position);
+    EXPECT_EQ(sizeof(PlayerCoordinate), position->size);
+    EXPECT_GT(latency_histogram_max(&position->latency), 0);
+
+    // Nothing is mapped past the fake guest memory
+    const uint64_t unmapped = FAKE_GUEST_MEMORY_BASE + FAKE_GUEST_MEMORY_SIZE + 0x1000;
+    int32_t value = 0;
+    EXPECT_EQ(READ_ERROR, read_4bytes((long long) unmapped, &value));
+
+    bool found = false;
+    for (size_t i = 0; i < read_stats_count(); i++) {
+        const ReadStats *stats = read_stats_get(i);
+        if (stats->address == unmapped) {
+            found = true;
+            EXPECT_EQ(1, stats->errors);
+        }
+    }
+    EXPECT_TRUE(found);
+}
@@ -0,0 +1,302 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "frame_data_analyser.hpp"
+#include "frame_export.h"
+#include "frame_exporter.hpp"
+#include "logging.h"
+#include "synthetic_frames.hpp"
+
+// Values around the enumerators and below this bound are checked as unknown ids
+#define UNKNOWN_ID_SWEEP 100000
+
+namespace {
+constexpr PlayerState ALL_STATES[] = {
+    PlayerState::STANDING,
+    PlayerState::CROUCH,
+    PlayerState::CROUCHING,
+    PlayerState::MOVE_BACKWARDS,
+    PlayerState::MOVE_FORWARDS,
+    PlayerState::RECOVER1,
+    PlayerState::RECOVER2,
+    PlayerState::STRING,
+    PlayerState::JUMPING,
+    PlayerState::JUMPING_FORWARDS,
+    PlayerState::JUMPING_BACKWARDS,
+    PlayerState::AIRBORNE,
+    PlayerState::GROUNDED1,
+    PlayerState::GROUNDED2,
+    PlayerState::DASH_FORWARDS,
+    PlayerState::DASH_BACKWARDS,
+    PlayerState::MOVE,
+    PlayerState::CROUCHING_ATTACK,
+    PlayerState::CROUCHING_BACKWARDS,
+    PlayerState::CROUCHING_FORWARDS,
+    PlayerState::STANDING_HIT,
+    PlayerState::CROUCH_DASH_JUMP,
+    PlayerState::POWER_STANCE,
+    PlayerState::SITTING,
+    PlayerState::SPINNING1,
+    PlayerState::SPINNING2,
+    PlayerState::SPIN_TO_STANDUP,
+    PlayerState::TRANSITION1,
+    PlayerState::TRANSITION2,
+    PlayerState::UNBLOCKABLE1,
+    PlayerState::UNBLOCKABLE2,
+    PlayerState::SLIDE1,
+    PlayerState::SLIDE2,
+    PlayerState::STAND_SWORD,
+};
+
+constexpr PlayerIntent ALL_INTENTS[] = {
+    PlayerIntent::IDLE,
+    PlayerIntent::ATTACK1,
+    PlayerIntent::ATTACK3,
+    PlayerIntent::ATTACK5,
+    PlayerIntent::ATTACK7,
+    PlayerIntent::INPUT_BUFFERING,
+    PlayerIntent::BLOCK,
+    PlayerIntent::WALK,
+    PlayerIntent::SIDE_STEP,
+    PlayerIntent::SIDE_ROLLING,
+    PlayerIntent::STASIS,
+    PlayerIntent::WHIFF,
+    PlayerIntent::DOUBLE_SIDE_STEP,
+    PlayerIntent::FALLING,
+    PlayerIntent::LANDING,
+    PlayerIntent::GRAP_INIT,
+    PlayerIntent::GRAP_CONNECT,
+};
+
+/**
+ * Status mapping of the switch the lookup table replaced, -Wswitch reports
+ * enumerators missing here
+ */
+const char *baseline_player_status(const PlayerState state) {
+    switch (state) {
+    case PlayerState::STANDING:
+    case PlayerState::MOVE_BACKWARDS:
+    case PlayerState::MOVE_FORWARDS:
+    case PlayerState::DASH_BACKWARDS:
+    case PlayerState::DASH_FORWARDS:
+    case PlayerState::MOVE:
+    case PlayerState::RECOVER1:
+    case PlayerState::RECOVER2:
+    case PlayerState::STRING:
+    case PlayerState::STANDING_HIT:
+    case PlayerState::CROUCH_DASH_JUMP:
+    case PlayerState::POWER_STANCE:
+    case PlayerState::SPINNING1:
+    case PlayerState::SPINNING2:
+    case PlayerState::SPIN_TO_STANDUP:
+    case PlayerState::TRANSITION1:
+    case PlayerState::TRANSITION2:
+    case PlayerState::UNBLOCKABLE1:
+    case PlayerState::UNBLOCKABLE2:
+    case PlayerState::SLIDE1:
+    case PlayerState::SLIDE2:
+    case PlayerState::STAND_SWORD:
+        return "Standing";
+    case PlayerState::CROUCH:
+    case PlayerState::SITTING:
+        return "Crouch";
+    case PlayerState::CROUCHING:
+    case PlayerState::CROUCHING_ATTACK:
+    case PlayerState::CROUCHING_BACKWARDS:
+    case PlayerState::CROUCHING_FORWARDS:
+        return "Crouching";
+    case PlayerState::JUMPING:
+    case PlayerState::JUMPING_FORWARDS:
+    case PlayerState::JUMPING_BACKWARDS:
+        return "Jumping";
+    case PlayerState::AIRBORNE:
+        return "Airborne";
+    case PlayerState::GROUNDED1:
+    case PlayerState::GROUNDED2:
+        return "Grounded";
+    }
+    return "Undeterminable";
+}
+
+/**
+ * Intent classification of the switch the lookup table replaced
+ */
+bool baseline_is_attack(const PlayerIntent intent) {
+    switch (intent) {
+    case PlayerIntent::ATTACK1:
+    case PlayerIntent::ATTACK3:
+    case PlayerIntent::ATTACK5:
+    case PlayerIntent::ATTACK7:
+        return true;
+    case PlayerIntent::IDLE:
+    case PlayerIntent::INPUT_BUFFERING:
+    case PlayerIntent::BLOCK:
+    case PlayerIntent::WALK:
+    case PlayerIntent::SIDE_STEP:
+    case PlayerIntent::DOUBLE_SIDE_STEP:
+    case PlayerIntent::FALLING:
+    case PlayerIntent::LANDING:
+    case PlayerIntent::STASIS:
+    case PlayerIntent::WHIFF:
+    case PlayerIntent::GRAP_INIT:
+    case PlayerIntent::GRAP_CONNECT:
+    case PlayerIntent::SIDE_ROLLING:
+        return false;
+    }
+    return false;
+}
+
+class RecordingListener : public EventListener {
+public:
+    std::vector<TickEvents> events;
+
+    void tick(const TickEvents &tick_events) override {
+        events.push_back(tick_events);
+    }
+};
+} // namespace
+
+class FrameDataAnalyserTest : public ::testing::Test {
+protected:
+    RecordingListener m_listener;
+
+    void SetUp() override {
+        FrameDataAnalyser::reset(&m_listener);
+    }
+
+    static void publish_frame_data(const FrameDataPoint &data_point) {
+        FrameDataAnalyser::publish_frame_data(data_point);
+    }
+
+    static void publish_distance(const float distance) {
+        FrameDataAnalyser::m_tick_events.distance = distance;
+        FrameDataAnalyser::m_tick_events.changed |= TICK_DISTANCE;
+    }
+
+    static void emit_tick_events() {
+        FrameDataAnalyser::emit_tick_events();
+    }
+
+    static bool is_attack(const PlayerIntent intent) {
+        return FrameDataAnalyser::is_attack(intent);
+    }
+};
+
+TEST_F(FrameDataAnalyserTest, StatusTableMatchesBaselineSwitch) {
+    // Unknown statuses are only logged
+    log_set_quiet(true);
+    for (const PlayerState state : ALL_STATES) {
+        EXPECT_STREQ(FrameDataAnalyser::player_status(state), baseline_player_status(state)) << (int) state;
+        for (const int offset : {-1, 1}) {
+            const auto neighbour = (PlayerState) ((int) state + offset);
+            EXPECT_STREQ(FrameDataAnalyser::player_status(neighbour), baseline_player_status(neighbour))
+                << (int) neighbour;
+        }
+    }
+    for (int value = -1; value < UNKNOWN_ID_SWEEP; value++) {
+        const auto state = (PlayerState) value;
+        ASSERT_STREQ(FrameDataAnalyser::player_status(state), baseline_player_status(state)) << value;
+    }
+    log_set_quiet(false);
+}
+
+TEST_F(FrameDataAnalyserTest, IntentTableMatchesBaselineSwitch) {
+    log_set_quiet(true);
+    for (const PlayerIntent intent : ALL_INTENTS) {
+        EXPECT_EQ(is_attack(intent), baseline_is_attack(intent)) << (int) intent;
+        for (const int offset : {-1, 1}) {
+            const auto neighbour = (PlayerIntent) ((int) intent + offset);
+            EXPECT_EQ(is_attack(neighbour), baseline_is_attack(neighbour)) << (int) neighbour;
+        }
+    }
+    for (int value = -1; value < UNKNOWN_ID_SWEEP; value++) {
+        const auto intent = (PlayerIntent) value;
+        ASSERT_EQ(is_attack(intent), baseline_is_attack(intent)) << value;
+    }
+    log_set_quiet(false);
+}
+
+TEST_F(FrameDataAnalyserTest, SameTickResultsAreBothDelivered) {
+    // Connection result followed by a string result in one tick
+    publish_frame_data({.startup_frames = 12, .frame_advantage = 2, .knock_down = false});
+    publish_frame_data({.startup_frames = 0, .frame_advantage = -5, .knock_down = true});
+    publish_distance(2.5F);
+    emit_tick_events();
+
+    ASSERT_EQ(m_listener.events.size(), 2);
+    EXPECT_EQ(m_listener.events[0].changed, TICK_FRAME_DATA);
+    EXPECT_EQ(m_listener.events[0].frame_data.startup_frames, 12);
+    EXPECT_EQ(m_listener.events[0].frame_data.frame_advantage, 2);
+
+    EXPECT_EQ(m_listener.events[1].changed, TICK_FRAME_DATA | TICK_DISTANCE);
+    EXPECT_EQ(m_listener.events[1].frame_data.frame_advantage, -5);
+    EXPECT_TRUE(m_listener.events[1].frame_data.knock_down);
+    EXPECT_FLOAT_EQ(m_listener.events[1].distance, 2.5F);
+}
+
+TEST_F(FrameDataAnalyserTest, SameTickResultsReachTheExporter) {
+    const std::string name = "/t6framedata_analyser_test_" + std::to_string(getpid());
+    ASSERT_TRUE(FrameExporter::start(name.c_str()));
+    const int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    ASSERT_GE(fd, 0);
+    void *shm = mmap(nullptr, sizeof(FrameExport), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    ASSERT_NE(shm, MAP_FAILED);
+
+    FrameDataAnalyser::push_frame(scenario_frames(Scenario::SINGLE_HIT)[0]);
+    publish_frame_data({.startup_frames = 12, .frame_advantage = 2, .knock_down = false});
+    publish_frame_data({.startup_frames = 0, .frame_advantage = -5, .knock_down = true});
+    emit_tick_events();
+
+    // Both results are published, the later one last
+    FrameExportSnapshot snapshot{};
+    frame_export_read((const FrameExport *) shm, &snapshot);
+    EXPECT_EQ(snapshot.tick, 2);
+    EXPECT_EQ(snapshot.frame_data_tick, 2);
+    EXPECT_EQ(snapshot.frame_data.frame_advantage, -5);
+    EXPECT_EQ(m_listener.events.size(), 2);
+
+    munmap(shm, sizeof(FrameExport));
+    FrameExporter::stop();
+}
+
+TEST_F(FrameDataAnalyserTest, SingleResultIsDeliveredOnce) {
+    const std::vector<GameFrame> frames = scenario_frames(Scenario::NATURAL_STRING);
+    FrameDataAnalyser::push_frame(frames[0]);
+    for (size_t i = 1; i < frames.size(); i++) {
+        FrameDataAnalyser::process_frame(frames[i]);
+    }
+
+    size_t results = 0;
+    for (const TickEvents &events : m_listener.events) {
+        if ((events.changed & TICK_FRAME_DATA) != 0) {
+            results++;
+            EXPECT_EQ(events.frame_data.startup_frames, 12);
+            EXPECT_EQ(events.frame_data.frame_advantage, 2);
+        }
+    }
+    EXPECT_EQ(results, 1);
+}
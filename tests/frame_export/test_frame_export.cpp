@@ -0,0 +1,150 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "frame_export.h"
+#include "frame_exporter.hpp"
+
+#define PUBLISHED_FRAMES 200000
+
+namespace {
+
+// Per process, tests run in parallel and must not touch the tool's segment
+const std::string SEGMENT_NAME = "/t6framedata_test_" + std::to_string(getpid());
+
+const FrameExport *map_reader() {
+    const int fd = shm_open(SEGMENT_NAME.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        return nullptr;
+    }
+    void *shm = mmap(nullptr, sizeof(FrameExport), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    return shm == MAP_FAILED ? nullptr : (const FrameExport *) shm;
+}
+
+GameFrame test_frame(const uint32_t game_frame) {
+    GameFrame frame{};
+    frame.game_frame = game_frame;
+    // Fields checked for consistency with the frame number
+    frame.p1.recovery_frames = game_frame;
+    frame.p2.recovery_frames = game_frame;
+    return frame;
+}
+
+} // namespace
+
+TEST(test_frame_export, publish_and_read) {
+    ASSERT_TRUE(FrameExporter::start(SEGMENT_NAME.c_str()));
+    const FrameExport *shm = map_reader();
+    ASSERT_NE(nullptr, shm);
+    ASSERT_TRUE(frame_export_valid(shm));
+
+    TickEvents events{};
+    FrameExporter::publish(test_frame(10), events);
+
+    FrameExportSnapshot snapshot{};
+    frame_export_read(shm, &snapshot);
+    ASSERT_EQ(1, snapshot.tick);
+    ASSERT_EQ(10, snapshot.game_frame.game_frame);
+    ASSERT_EQ(0, snapshot.frame_data_tick);
+
+    events.changed = TICK_FRAME_DATA;
+    events.frame_data = {.startup_frames = 12, .frame_advantage = -3, .knock_down = true};
+    FrameExporter::publish(test_frame(11), events);
+
+    // Frame data is kept while later ticks have none
+    events.changed = 0;
+    FrameExporter::publish(test_frame(12), events);
+
+    frame_export_read(shm, &snapshot);
+    ASSERT_EQ(3, snapshot.tick);
+    ASSERT_EQ(12, snapshot.game_frame.game_frame);
+    ASSERT_EQ(2, snapshot.frame_data_tick);
+    ASSERT_EQ(12, snapshot.frame_data.startup_frames);
+    ASSERT_EQ(-3, snapshot.frame_data.frame_advantage);
+    ASSERT_EQ(1, snapshot.frame_data.knock_down);
+
+    munmap((void *) shm, sizeof(FrameExport));
+    FrameExporter::stop();
+}
+
+TEST(test_frame_export, concurrent_reader_sees_consistent_snapshots) {
+    ASSERT_TRUE(FrameExporter::start(SEGMENT_NAME.c_str()));
+    const FrameExport *shm = map_reader();
+    ASSERT_NE(nullptr, shm);
+
+    std::atomic<bool> done = false;
+    std::atomic<int> torn = 0;
+    std::thread reader([&] {
+        FrameExportSnapshot snapshot{};
+        uint64_t last_tick = 0;
+        while (!done) {
+            frame_export_read(shm, &snapshot);
+            if (snapshot.game_frame.p1.recovery_frames != snapshot.game_frame.game_frame ||
+                snapshot.game_frame.p2.recovery_frames != snapshot.game_frame.game_frame ||
+                snapshot.tick < last_tick) {
+                torn++;
+            }
+            last_tick = snapshot.tick;
+            std::this_thread::yield();
+        }
+    });
+
+    const TickEvents events{};
+    for (uint32_t i = 1; i <= PUBLISHED_FRAMES; i++) {
+        FrameExporter::publish(test_frame(i), events);
+    }
+    done = true;
+    reader.join();
+
+    ASSERT_EQ(0, torn.load());
+    munmap((void *) shm, sizeof(FrameExport));
+    FrameExporter::stop();
+}
+
+TEST(test_frame_export, segment_removed_on_stop) {
+    ASSERT_TRUE(FrameExporter::start(SEGMENT_NAME.c_str()));
+    FrameExporter::stop();
+    ASSERT_FALSE(FrameExporter::enabled());
+    ASSERT_EQ(nullptr, map_reader());
+}
+
+TEST(test_frame_export, refuses_segment_owned_by_another_writer) {
+    // Writer of another process holds the lock
+    const int fd = shm_open(SEGMENT_NAME.c_str(), O_CREAT | O_RDWR, 0644);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(0, flock(fd, LOCK_EX | LOCK_NB));
+
+    ASSERT_FALSE(FrameExporter::start(SEGMENT_NAME.c_str()));
+    ASSERT_FALSE(FrameExporter::enabled());
+
+    // Taken over once the owner is gone
+    close(fd);
+    ASSERT_TRUE(FrameExporter::start(SEGMENT_NAME.c_str()));
+    FrameExporter::stop();
+    ASSERT_EQ(nullptr, map_reader());
+}
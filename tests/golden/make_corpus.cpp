@@ -0,0 +1,208 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+// Writes the synthetic sessions of the golden corpus as frame traces
+//
+// Usage: make_corpus <directory>
+//
+// Sessions recorded from the game with --trace-frames belong in the same
+// directory, golden outputs of all sessions come from replay_session --update.
+
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "frame_trace.hpp"
+
+#include "synthetic_frames.hpp"
+
+// Constants
+#define SESSION_ROUNDS 10
+
+namespace {
+
+struct Round {
+    Scenario scenario;
+    // Attacks of the round, the scenario's own if empty
+    std::vector<ScenarioHit> hits;
+    // Players swapped so that P2 attacks
+    bool p2_attacks;
+};
+
+struct Session {
+    const char *name;
+    std::vector<Round> rounds;
+    // Opponent is knocked down on every other round
+    bool knock_downs;
+};
+
+std::vector<Round> repeat(const Scenario scenario, const size_t count) {
+    return std::vector(count, Round{.scenario = scenario, .hits = {}, .p2_attacks = false});
+}
+
+std::vector<GameFrame> session_frames(const Session &session) {
+    std::vector<GameFrame> frames;
+    int32_t attack_seq[2] = {0, 0};
+
+    for (size_t round = 0; round < session.rounds.size(); round++) {
+        const Round &current = session.rounds[round];
+        const std::vector<ScenarioHit> hits = current.hits.empty() ? scenario_hits(current.scenario) : current.hits;
+        int32_t &attacker_seq = attack_seq[current.p2_attacks ? 1 : 0];
+
+        for (GameFrame frame : scenario_frames(current.scenario, hits)) {
+            frame.game_frame = SCENARIO_FIRST_FRAME + (uint32_t) frames.size();
+            frame.p1.attack_seq += attacker_seq;
+            if (session.knock_downs && round % 2 == 1 && frame.p2.state == (int32_t) PlayerState::STANDING_HIT) {
+                frame.p2.state = (int32_t) PlayerState::AIRBORNE;
+            }
+            if (current.p2_attacks) {
+                std::swap(frame.p1, frame.p2);
+                frame.p1.attack_seq = attack_seq[0];
+            } else {
+                frame.p2.attack_seq = attack_seq[1];
+            }
+            frames.push_back(frame);
+        }
+        attacker_seq += (int32_t) hits.size();
+    }
+
+    return frames;
+}
+
+bool write_session(const std::string &path, const std::vector<GameFrame> &frames) {
+    FILE *file = fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        (void) fprintf(stderr, "failed to open %s\n", path.c_str());
+        return false;
+    }
+
+    bool written = FrameTrace::write_header(file);
+    for (const GameFrame &frame : frames) {
+        written = written && FrameTrace::write_frame(file, frame);
+    }
+    written = fclose(file) == 0 && written;
+    return written;
+}
+
+} // namespace
+
+int main(const int argc, const char **argv) {
+    if (argc != 2) {
+        (void) fprintf(stderr, "usage: %s <directory>\n", argv[0]); // NOLINT
+        return 1;
+    }
+
+    const std::vector<Session> sessions = {
+        {.name = "single_hit", .rounds = repeat(Scenario::SINGLE_HIT, SESSION_ROUNDS), .knock_downs = false},
+        {.name = "natural_string", .rounds = repeat(Scenario::NATURAL_STRING, SESSION_ROUNDS), .knock_downs = false},
+        {.name = "multi_hit", .rounds = repeat(Scenario::MULTI_HIT, SESSION_ROUNDS), .knock_downs = false},
+        {.name = "mixed_knock_down",
+         .rounds = {{.scenario = Scenario::SINGLE_HIT, .hits = {}, .p2_attacks = false},
+                    {.scenario = Scenario::NATURAL_STRING, .hits = {}, .p2_attacks = false},
+                    {.scenario = Scenario::MULTI_HIT, .hits = {}, .p2_attacks = false},
+                    {.scenario = Scenario::NATURAL_STRING, .hits = {}, .p2_attacks = false},
+                    {.scenario = Scenario::SINGLE_HIT, .hits = {}, .p2_attacks = false},
+                    {.scenario = Scenario::MULTI_HIT, .hits = {}, .p2_attacks = false}},
+         .knock_downs = true},
+        // Fast to slow startups, plus and minus on hit
+        {.name = "varied_startup",
+         .rounds = {{.scenario = Scenario::SINGLE_HIT,
+                     .hits = {{.start = 10, .connection = 17, .recovery = 22, .hit_stun = 20}},
+                     .p2_attacks = false},
+                    {.scenario = Scenario::SINGLE_HIT,
+                     .hits = {{.start = 10, .connection = 19, .recovery = 30, .hit_stun = 14}},
+                     .p2_attacks = false},
+                    {.scenario = Scenario::SINGLE_HIT,
+                     .hits = {{.start = 5, .connection = 20, .recovery = 40, .hit_stun = 18}},
+                     .p2_attacks = false},
+                    {.scenario = Scenario::SINGLE_HIT,
+                     .hits = {{.start = 5, .connection = 26, .recovery = 45, .hit_stun = 30}},
+                     .p2_attacks = false},
+                    {.scenario = Scenario::SINGLE_HIT,
+                     .hits = {{.start = 10, .connection = 23, .recovery = 26, .hit_stun = 16}},
+                     .p2_attacks = false},
+                    {.scenario = Scenario::SINGLE_HIT,
+                     .hits = {{.start = 2, .connection = 35, .recovery = 50, .hit_stun = 24}},
+                     .p2_attacks = false}},
+         .knock_downs = false},
+        // Two and three hit strings with different startups and gaps
+        {.name = "natural_strings",
+         .rounds = {{.scenario = Scenario::NATURAL_STRING,
+                     .hits = {{.start = 10, .connection = 18, .recovery = 24, .hit_stun = 18},
+                              {.start = 21, .connection = 31, .recovery = 28, .hit_stun = 22}},
+                     .p2_attacks = false},
+                    {.scenario = Scenario::NATURAL_STRING,
+                     .hits = {{.start = 8, .connection = 15, .recovery = 20, .hit_stun = 16},
+                              {.start = 18, .connection = 26, .recovery = 22, .hit_stun = 18},
+                              {.start = 29, .connection = 40, .recovery = 34, .hit_stun = 26}},
+                     .p2_attacks = false},
+                    {.scenario = Scenario::NATURAL_STRING,
+                     .hits = {{.start = 5, .connection = 21, .recovery = 36, .hit_stun = 24},
+                              {.start = 24, .connection = 30, .recovery = 20, .hit_stun = 20}},
+                     .p2_attacks = false},
+                    {.scenario = Scenario::NATURAL_STRING,
+                     .hits = {{.start = 10, .connection = 20, .recovery = 30, .hit_stun = 20},
+                              {.start = 22, .connection = 29, .recovery = 24, .hit_stun = 12},
+                              {.start = 32, .connection = 45, .recovery = 36, .hit_stun = 30}},
+                     .p2_attacks = false}},
+         .knock_downs = false},
+        // Multi-hits whose last hit leaves the attacker plus, even and minus
+        {.name = "multi_hit_advantage",
+         .rounds = {{.scenario = Scenario::MULTI_HIT,
+                     .hits = {{.start = 10, .connection = 20, .recovery = 30, .hit_stun = 20},
+                              {.start = 22, .connection = 24, .recovery = 18, .hit_stun = 20},
+                              {.start = 26, .connection = 28, .recovery = 16, .hit_stun = 24}},
+                     .p2_attacks = false},
+                    {.scenario = Scenario::MULTI_HIT,
+                     .hits = {{.start = 10, .connection = 24, .recovery = 30, .hit_stun = 20},
+                              {.start = 26, .connection = 28, .recovery = 22, .hit_stun = 12},
+                              {.start = 30, .connection = 32, .recovery = 26, .hit_stun = 10}},
+                     .p2_attacks = false},
+                    {.scenario = Scenario::MULTI_HIT,
+                     .hits = {{.start = 6, .connection = 14, .recovery = 24, .hit_stun = 20},
+                              {.start = 16, .connection = 18, .recovery = 20, .hit_stun = 20},
+                              {.start = 20, .connection = 22, .recovery = 20, .hit_stun = 20},
+                              {.start = 24, .connection = 26, .recovery = 20, .hit_stun = 18}},
+                     .p2_attacks = false}},
+         .knock_downs = false},
+        // Both players attacking, knock downs on every other round
+        {.name = "mixed_players",
+         .rounds = {{.scenario = Scenario::SINGLE_HIT, .hits = {}, .p2_attacks = true},
+                    {.scenario = Scenario::NATURAL_STRING, .hits = {}, .p2_attacks = false},
+                    {.scenario = Scenario::MULTI_HIT, .hits = {}, .p2_attacks = true},
+                    {.scenario = Scenario::SINGLE_HIT,
+                     .hits = {{.start = 10, .connection = 19, .recovery = 26, .hit_stun = 22}},
+                     .p2_attacks = true},
+                    {.scenario = Scenario::NATURAL_STRING,
+                     .hits = {{.start = 8, .connection = 15, .recovery = 20, .hit_stun = 16},
+                              {.start = 18, .connection = 26, .recovery = 22, .hit_stun = 18}},
+                     .p2_attacks = true},
+                    {.scenario = Scenario::SINGLE_HIT, .hits = {}, .p2_attacks = false}},
+         .knock_downs = true},
+    };
+
+    for (const Session &session : sessions) {
+        const std::string path = std::string(argv[1]) + "/" + session.name + ".t6trace"; // NOLINT
+        if (!write_session(path, session_frames(session))) {
+            return 1;
+        }
+        (void) printf("wrote %s\n", path.c_str());
+    }
+
+    return 0;
+}
@@ -0,0 +1,204 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+// Replays a recorded frame trace through the analyser and compares the frame
+// data it reports with the session's golden output
+//
+// Usage: replay_session <trace> <expected> [--update]
+//
+// Output lines are keyed by the game frame the data point was reported on and
+// its order among the frame's data points, and list the players' moves, so the
+// diff report shows which moves changed result.
+// --update rewrites the expected output from the current analyser.
+
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "frame_data_analyser.hpp"
+#include "frame_trace.hpp"
+#include "logging.h"
+
+// Constants
+#define GOLDEN_LINE_SIZE 128
+
+namespace {
+
+// Frame being analysed when the listener is called
+GameFrame g_frame{};
+
+class Listener : public EventListener {
+public:
+    std::vector<std::string> lines;
+
+    void tick(const TickEvents &events) override {
+        if ((events.changed & TICK_FRAME_DATA) == 0) {
+            return;
+        }
+
+        char line[GOLDEN_LINE_SIZE];
+        (void) snprintf(line,
+                        sizeof(line),
+                        "frame=%u p1_move=%d p2_move=%d startup=%d advantage=%d knock_down=%d",
+                        g_frame.game_frame,
+                        g_frame.p1.move,
+                        g_frame.p2.move,
+                        events.frame_data.startup_frames,
+                        events.frame_data.frame_advantage,
+                        (int) events.frame_data.knock_down);
+        lines.emplace_back(line);
+    }
+};
+
+bool replay(const char *path, Listener *listener) {
+    FILE *file = fopen(path, "rb");
+    if (file == nullptr) {
+        (void) fprintf(stderr, "failed to open trace %s\n", path);
+        return false;
+    }
+
+    if (!FrameTrace::read_header(file)) {
+        (void) fclose(file);
+        return false;
+    }
+
+    FrameDataAnalyser::reset(listener);
+    while (fread(&g_frame, sizeof(g_frame), 1, file) == 1) {
+        FrameDataAnalyser::process_frame(g_frame);
+    }
+
+    (void) fclose(file);
+    return true;
+}
+
+bool read_lines(const char *path, std::vector<std::string> *lines) {
+    FILE *file = fopen(path, "r");
+    if (file == nullptr) {
+        (void) fprintf(stderr, "failed to open expected output %s\n", path);
+        return false;
+    }
+
+    char line[GOLDEN_LINE_SIZE];
+    while (fgets(line, sizeof(line), file) != nullptr) {
+        line[strcspn(line, "\n")] = '\0'; // NOLINT
+        if (line[0] != '\0' && line[0] != '#') {
+            lines->emplace_back(line);
+        }
+    }
+
+    (void) fclose(file);
+    return true;
+}
+
+bool write_lines(const char *path, const std::vector<std::string> &lines) {
+    FILE *file = fopen(path, "w");
+    if (file == nullptr) {
+        (void) fprintf(stderr, "failed to open %s for writing\n", path);
+        return false;
+    }
+
+    for (const std::string &line : lines) {
+        (void) fprintf(file, "%s\n", line.c_str());
+    }
+
+    (void) fclose(file);
+    return true;
+}
+
+// "frame=N" of a line and its order among the lines of that frame
+using LineKey = std::pair<std::string, size_t>;
+
+/**
+ * Index lines by their frame and order within the frame, several data points
+ * of one frame are all kept
+ */
+std::map<LineKey, std::string> by_frame(const std::vector<std::string> &lines) {
+    std::map<LineKey, std::string> indexed;
+    std::map<std::string, size_t> frame_lines;
+    for (const std::string &line : lines) {
+        const std::string frame = line.substr(0, line.find(' '));
+        indexed[{frame, frame_lines[frame]++}] = line;
+    }
+    return indexed;
+}
+
+/**
+ * Print changed, missing and unexpected frame data points
+ *
+ * @return number of differences
+ */
+int diff_report(const char *session, const std::vector<std::string> &expected, const std::vector<std::string> &actual) {
+    const std::map<LineKey, std::string> expected_lines = by_frame(expected);
+    const std::map<LineKey, std::string> actual_lines = by_frame(actual);
+    int differences = 0;
+
+    for (const auto &[key, line] : expected_lines) {
+        const auto found = actual_lines.find(key);
+        if (found == actual_lines.end()) {
+            (void) printf("%s: missing   %s\n", session, line.c_str());
+            differences++;
+        } else if (found->second != line) {
+            (void) printf("%s: changed   %s\n%s:        -> %s\n", session, line.c_str(), session, found->second.c_str());
+            differences++;
+        }
+    }
+
+    for (const auto &[key, line] : actual_lines) {
+        if (!expected_lines.contains(key)) {
+            (void) printf("%s: unexpected %s\n", session, line.c_str());
+            differences++;
+        }
+    }
+
+    return differences;
+}
+
+} // namespace
+
+int main(const int argc, const char **argv) {
+    const bool update = argc == 4 && strcmp(argv[3], "--update") == 0; // NOLINT
+    if (argc != 3 && !update) {
+        (void) fprintf(stderr, "usage: %s <trace> <expected> [--update]\n", argv[0]); // NOLINT
+        return 1;
+    }
+    const char *trace_path = argv[1]; // NOLINT
+    const char *expected_path = argv[2]; // NOLINT
+
+    // Analyser diagnostics are not part of the golden output
+    log_set_level(LOG_FATAL);
+
+    Listener listener;
+    if (!replay(trace_path, &listener)) {
+        return 1;
+    }
+
+    if (update) {
+        return write_lines(expected_path, listener.lines) ? 0 : 1;
+    }
+
+    std::vector<std::string> expected;
+    if (!read_lines(expected_path, &expected)) {
+        return 1;
+    }
+
+    const int differences = diff_report(trace_path, expected, listener.lines);
+    (void) printf("%s: %zu frame data points, %d differences\n", trace_path, listener.lines.size(), differences);
+    return differences == 0 ? 0 : 1;
+}
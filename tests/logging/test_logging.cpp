@@ -0,0 +1,192 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "logging.h"
+
+// More threads than the asynchronous rings of logging.c
+#define MAX_RING_THREADS 16
+#define CONCURRENT_THREADS (MAX_RING_THREADS + 8)
+#define SEQUENTIAL_THREADS (MAX_RING_THREADS * 4)
+#define BURST_MESSAGES 10000
+#define LATE_WRITERS 4
+
+namespace {
+
+int g_capture = -1;
+
+/**
+ * Send stderr, and so the asynchronous output stream duplicated from it, to a
+ * file for the whole test program
+ */
+class CaptureStderr : public ::testing::Environment {
+public:
+    void SetUp() override {
+        char path[] = "/tmp/test_logging_XXXXXX";
+        g_capture = mkstemp(path);
+        ASSERT_GE(g_capture, 0);
+        (void) unlink(path);
+        ASSERT_GE(dup2(g_capture, STDERR_FILENO), 0);
+    }
+};
+
+[[maybe_unused]] const auto *const g_environment = ::testing::AddGlobalTestEnvironment(new CaptureStderr);
+
+struct Captured {
+    std::vector<std::string> lines;
+
+    // Lines containing text
+    size_t count(const char *text) const {
+        size_t found = 0;
+        for (const std::string &line : lines) {
+            found += line.find(text) != std::string::npos ? 1 : 0;
+        }
+        return found;
+    }
+
+    // Sum of the "N log messages dropped" reports
+    size_t dropped() const {
+        size_t total = 0;
+        for (const std::string &line : lines) {
+            if (line.ends_with(" log messages dropped")) {
+                total += strtoul(line.c_str(), nullptr, 10); // NOLINT
+            }
+        }
+        return total;
+    }
+};
+
+class test_logging : public ::testing::Test {
+protected:
+    off_t m_start = 0;
+
+    void SetUp() override {
+        m_start = lseek(g_capture, 0, SEEK_END);
+    }
+
+    // Lines written since the test started
+    Captured captured() const {
+        Captured result;
+        const off_t end = lseek(g_capture, 0, SEEK_END);
+        std::string text((size_t) (end - m_start), '\0');
+        EXPECT_EQ(pread(g_capture, text.data(), text.size(), m_start), (ssize_t) text.size());
+
+        size_t begin = 0;
+        for (size_t newline = text.find('\n'); newline != std::string::npos; newline = text.find('\n', begin)) {
+            result.lines.push_back(text.substr(begin, newline - begin));
+            begin = newline + 1;
+        }
+        return result;
+    }
+};
+
+} // namespace
+
+TEST_F(test_logging, exited_threads_release_their_rings) {
+    ASSERT_EQ(log_start_async(), 0);
+    for (int i = 0; i < SEQUENTIAL_THREADS; i++) {
+        std::thread([i]() { log_info("sequential thread %d", i); }).join();
+    }
+    log_stop_async();
+
+    const Captured output = captured();
+    EXPECT_EQ(output.count("sequential thread"), SEQUENTIAL_THREADS);
+    // Every thread found a released ring
+    EXPECT_EQ(output.count("logging the rest synchronously"), 0);
+}
+
+TEST_F(test_logging, full_ring_counts_dropped_messages) {
+    ASSERT_EQ(log_start_async(), 0);
+    for (int i = 0; i < BURST_MESSAGES; i++) {
+        log_info("burst message %d", i);
+    }
+    log_stop_async();
+
+    const Captured output = captured();
+    EXPECT_GT(output.dropped(), 0);
+    EXPECT_EQ(output.count("burst message") + output.dropped(), BURST_MESSAGES);
+}
+
+TEST_F(test_logging, stop_writes_messages_of_late_writers) {
+    std::atomic<bool> stopped = false;
+    std::atomic<size_t> logged = 0;
+
+    ASSERT_EQ(log_start_async(), 0);
+    std::vector<std::thread> writers;
+    for (int i = 0; i < LATE_WRITERS; i++) {
+        writers.emplace_back([&]() {
+            // Keep logging across log_stop_async, later messages are written synchronously
+            for (int message = 0; !stopped || message < 100; message++) {
+                log_info("late writer message %d", message);
+                logged++;
+                std::this_thread::yield();
+            }
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    log_stop_async();
+    stopped = true;
+    for (std::thread &writer : writers) {
+        writer.join();
+    }
+
+    // Nothing queued is left behind in the rings
+    const Captured output = captured();
+    EXPECT_EQ(output.count("late writer message") + output.dropped(), logged.load());
+}
+
+TEST_F(test_logging, threads_beyond_ring_limit_log_synchronously) {
+    std::atomic<int> waiting = CONCURRENT_THREADS;
+
+    ASSERT_EQ(log_start_async(), 0);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < CONCURRENT_THREADS; i++) {
+        threads.emplace_back([&waiting, i]() {
+            log_info("concurrent thread %d", i);
+            // Hold the rings until every thread has logged
+            waiting--;
+            while (waiting > 0) {
+                std::this_thread::yield();
+            }
+            log_info("concurrent thread %d again", i);
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    log_stop_async();
+
+    const Captured output = captured();
+    EXPECT_EQ(output.count("logging the rest synchronously"), 1);
+    EXPECT_EQ(output.count("concurrent thread") + output.dropped(), CONCURRENT_THREADS * 2);
+    // Synchronous and batched messages share the stream without interleaving
+    for (const std::string &line : output.lines) {
+        EXPECT_TRUE(line.find("log messages dropped") != std::string::npos || line.find(" INFO ") != std::string::npos ||
+                    line.find(" WARN ") != std::string::npos)
+            << line;
+    }
+}
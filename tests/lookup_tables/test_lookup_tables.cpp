@@ -0,0 +1,118 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "lookup_tables.hpp"
+
+#define COUNTER_SIZE 3
+
+namespace {
+constexpr std::array<LookupEntry<int>, 6> ENTRIES = {{
+    {.key = 0, .value = 1},
+    {.key = 2114, .value = 2},
+    {.key = 8390722, .value = 3},
+    {.key = 16806918, .value = 4},
+    {.key = 65539, .value = 5},
+    {.key = -1, .value = 6},
+}};
+
+constexpr PerfectHashTable<int, ENTRIES.size()> TABLE(ENTRIES, -100);
+} // namespace
+
+TEST(test_lookup_tables, compile_time_lookup) {
+    static_assert(TABLE.get(8390722) == 3);
+    static_assert(TABLE.get(12345) == -100);
+    static_assert(TABLE.contains(0));
+}
+
+TEST(test_lookup_tables, known_keys) {
+    for (const auto &entry : ENTRIES) {
+        ASSERT_TRUE(TABLE.contains(entry.key));
+        ASSERT_EQ(entry.value, TABLE.get(entry.key));
+    }
+}
+
+TEST(test_lookup_tables, unknown_keys) {
+    for (int32_t key = 1; key < 100000; key++) {
+        if (key == 2114 || key == 65539) {
+            continue;
+        }
+        ASSERT_FALSE(TABLE.contains(key));
+        ASSERT_EQ(-100, TABLE.get(key));
+    }
+}
+
+TEST(test_lookup_tables, unknown_id_counter) {
+    UnknownIdCounter<COUNTER_SIZE> counter;
+
+    ASSERT_EQ(0, counter.size());
+    ASSERT_TRUE(counter.record(10));
+    ASSERT_FALSE(counter.record(10));
+    ASSERT_TRUE(counter.record(20));
+    ASSERT_TRUE(counter.record(30));
+
+    ASSERT_EQ(3, counter.size());
+    ASSERT_EQ(10, counter.id(0));
+    ASSERT_EQ(2, counter.hits(0));
+    ASSERT_EQ(1, counter.hits(2));
+
+    // Table full, every sighting is counted
+    ASSERT_FALSE(counter.record(40));
+    ASSERT_FALSE(counter.record(40));
+    ASSERT_FALSE(counter.record(50));
+    ASSERT_EQ(3, counter.size());
+    ASSERT_EQ(3, counter.untracked_sightings());
+}
+
+TEST(test_lookup_tables, unknown_id_counter_concurrent) {
+    constexpr int THREADS = 8;
+    constexpr int ROUNDS = 1000;
+    UnknownIdCounter<COUNTER_SIZE> counter;
+    std::atomic<int> first_sightings = 0;
+
+    // Every thread records the same new ids at once
+    std::vector<std::thread> threads;
+    for (int i = 0; i < THREADS; i++) {
+        threads.emplace_back([&counter, &first_sightings] {
+            for (int round = 0; round < ROUNDS; round++) {
+                for (int32_t id = -1; id < COUNTER_SIZE - 1; id++) {
+                    if (counter.record(id)) {
+                        first_sightings++;
+                    }
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(COUNTER_SIZE, first_sightings.load());
+    ASSERT_EQ(COUNTER_SIZE, counter.size());
+    for (size_t i = 0; i < COUNTER_SIZE; i++) {
+        ASSERT_EQ(THREADS * ROUNDS, counter.hits(i));
+        for (size_t j = 0; j < i; j++) {
+            ASSERT_NE(counter.id(i), counter.id(j));
+        }
+    }
+    ASSERT_EQ(0, counter.untracked_sightings());
+}
@@ -0,0 +1,368 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+// Guest memory read strategy benchmark
+//
+// Reads snapshots of 4-byte big-endian fields from the fake emulator with:
+//   per-field   one process_vm_readv per field, as read_4bytes does
+//   vectored    one process_vm_readv with an iovec per field
+//   proc-mem    one pread per field on /proc/PID/mem
+//   direct      reads from the emulator's guest memory mapped into this process
+//
+// Field layouts are the game's own addresses and synthetic ones of varying
+// field count and spread. Reports system calls per snapshot, p50/p99 snapshot
+// latency, snapshot throughput and the CPU cost of reading at 120 Hz.
+//
+// Usage: read_bench [snapshots]
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "address_config.h"
+#include "number_conversions.h"
+
+#include "fake_emulator.hpp"
+
+// Constants
+#define DEFAULT_SNAPSHOTS 20000
+#define WARMUP_SNAPSHOTS 100
+#define TICK_RATE 120
+#define EXIT_SKIP 77
+// Guest address of the synthetic layouts
+#define SYNTHETIC_BASE 0x20000000
+
+namespace {
+
+struct Layout {
+    std::string name;
+    std::vector<uint64_t> addresses;
+};
+
+struct Reader {
+    pid_t pid;
+    int mem_fd;
+    const char *mapping;
+};
+
+// Reads the layout into values, returns the number of system calls made
+using ReadFunction = int (*)(const Reader &reader, const Layout &layout, uint32_t *values);
+
+struct Strategy {
+    const char *name;
+    ReadFunction read;
+};
+
+struct Result {
+    int syscalls;
+    double p50_us;
+    double p99_us;
+    double snapshots_per_second;
+    double cpu_ms_per_second;
+};
+
+double elapsed_us(const timespec &start, const timespec &end) {
+    return ((double) (end.tv_sec - start.tv_sec) * 1e6) + ((double) (end.tv_nsec - start.tv_nsec) / 1e3);
+}
+
+int read_per_field(const Reader &reader, const Layout &layout, uint32_t *values) {
+    for (size_t i = 0; i < layout.addresses.size(); i++) {
+        iovec local = {.iov_base = &values[i], .iov_len = 4};
+        iovec remote = {.iov_base = (void *) layout.addresses[i], .iov_len = 4}; // NOLINT
+        if (process_vm_readv(reader.pid, &local, 1, &remote, 1, 0) != 4) {
+            return -1;
+        }
+        values[i] = __builtin_bswap32(values[i]);
+    }
+    return (int) layout.addresses.size();
+}
+
+int read_vectored(const Reader &reader, const Layout &layout, uint32_t *values) {
+    static iovec local[IOV_MAX];
+    static iovec remote[IOV_MAX];
+
+    int syscalls = 0;
+    for (size_t first = 0; first < layout.addresses.size(); first += IOV_MAX) {
+        const size_t count = std::min(layout.addresses.size() - first, (size_t) IOV_MAX);
+        for (size_t i = 0; i < count; i++) {
+            local[i] = {.iov_base = &values[first + i], .iov_len = 4};
+            remote[i] = {.iov_base = (void *) layout.addresses[first + i], .iov_len = 4}; // NOLINT
+        }
+        if (process_vm_readv(reader.pid, local, count, remote, count, 0) != (ssize_t) (count * 4)) {
+            return -1;
+        }
+        syscalls++;
+    }
+
+    for (size_t i = 0; i < layout.addresses.size(); i++) {
+        values[i] = __builtin_bswap32(values[i]);
+    }
+    return syscalls;
+}
+
+int read_proc_mem(const Reader &reader, const Layout &layout, uint32_t *values) {
+    for (size_t i = 0; i < layout.addresses.size(); i++) {
+        if (pread(reader.mem_fd, &values[i], 4, (off_t) layout.addresses[i]) != 4) {
+            return -1;
+        }
+        values[i] = __builtin_bswap32(values[i]);
+    }
+    return (int) layout.addresses.size();
+}
+
+int read_direct(const Reader &reader, const Layout &layout, uint32_t *values) {
+    for (size_t i = 0; i < layout.addresses.size(); i++) {
+        uint32_t value = 0;
+        memcpy(&value, &reader.mapping[layout.addresses[i] - FAKE_GUEST_MEMORY_BASE], 4); // NOLINT
+        values[i] = __builtin_bswap32(value);
+    }
+    return 0;
+}
+
+/**
+ * Map the emulator's guest memory object through its file descriptor
+ *
+ * @return mapping or nullptr
+ */
+const char *map_guest_memory(const pid_t pid) {
+    const std::string fd_directory = "/proc/" + std::to_string(pid) + "/fd";
+    DIR *dir = opendir(fd_directory.c_str());
+    if (dir == nullptr) {
+        return nullptr;
+    }
+
+    const char *mapping = nullptr;
+    const dirent *entry = nullptr;
+    while (mapping == nullptr && (entry = readdir(dir)) != nullptr) { // NOLINT
+        const std::string path = fd_directory + "/" + entry->d_name; // NOLINT
+        char target[PATH_MAX] = {};
+        if (readlink(path.c_str(), target, sizeof(target) - 1) < 0 ||
+            strstr(target, FAKE_GUEST_MEMORY_NAME) == nullptr) {
+            continue;
+        }
+
+        const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            continue;
+        }
+        void *memory = mmap(nullptr, FAKE_GUEST_MEMORY_SIZE, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (memory != MAP_FAILED) {
+            mapping = (const char *) memory;
+        }
+    }
+
+    closedir(dir);
+    return mapping;
+}
+
+uint64_t resolve_pointer(const Reader &reader, const uint64_t pointer, const uint32_t offset) {
+    uint32_t value = 0;
+    const Layout layout = {.name = "", .addresses = {pointer}};
+    if (read_per_field(reader, layout, &value) < 0) {
+        return 0;
+    }
+    return ps3_address_to_x64(value + offset);
+}
+
+Layout game_layout(const Reader &reader) {
+    Layout layout = {.name = "game",
+                     .addresses = {CURRENT_GAME_FRAME,
+                                   P1_FRAMES_LAST_ACTION,
+                                   P1_RECOVERY_FRAMES,
+                                   P1_CONNECTION_BOOL,
+                                   P1_INTENT,
+                                   P1_MOVE,
+                                   P1_STATE,
+                                   P1_STRING_TYPE,
+                                   P1_STRING_STATE,
+                                   P1_POSITION,
+                                   P1_POSITION + 4,
+                                   P1_POSITION + 8,
+                                   P2_FRAMES_LAST_ACTION,
+                                   P2_RECOVERY_FRAMES,
+                                   P2_CONNECTION_BOOL,
+                                   P2_INTENT,
+                                   P2_MOVE,
+                                   P2_STATE,
+                                   P2_STRING_TYPE,
+                                   P2_STRING_STATE,
+                                   P2_POSITION,
+                                   P2_POSITION + 4,
+                                   P2_POSITION + 8}};
+
+    // Pointer chains are resolved once, like init_memory_reader does
+    layout.addresses.push_back(resolve_pointer(reader, P1_ATTACK_SEQ_PTR, P1_ATTACK_SEQ_OFFSET));
+    layout.addresses.push_back(resolve_pointer(reader, P2_ATTACK_SEQ_PTR, P2_ATTACK_SEQ_OFFSET));
+    layout.addresses.push_back(resolve_pointer(reader, PLAYER_SIDE_PTR, PLAYER_SIDE_OFFSET));
+    return layout;
+}
+
+Layout synthetic_layout(const size_t fields, const uint64_t spread) {
+    Layout layout = {.name = std::to_string(fields) + " x " + std::to_string(spread) + "B", .addresses = {}};
+    for (size_t i = 0; i < fields; i++) {
+        layout.addresses.push_back(ps3_address_to_x64(SYNTHETIC_BASE) + (i * spread));
+    }
+    return layout;
+}
+
+bool run_strategy(const Reader &reader, const Layout &layout, const Strategy &strategy, const int snapshots,
+                  Result *result) {
+    std::vector<uint32_t> values(layout.addresses.size());
+    std::vector<double> latencies(snapshots);
+
+    for (int i = 0; i < WARMUP_SNAPSHOTS; i++) {
+        if (strategy.read(reader, layout, values.data()) < 0) {
+            return false;
+        }
+    }
+
+    timespec cpu_start{};
+    timespec wall_start{};
+    (void) clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpu_start);
+    (void) clock_gettime(CLOCK_MONOTONIC, &wall_start);
+
+    for (int i = 0; i < snapshots; i++) {
+        timespec start{};
+        timespec end{};
+        (void) clock_gettime(CLOCK_MONOTONIC, &start);
+        result->syscalls = strategy.read(reader, layout, values.data());
+        (void) clock_gettime(CLOCK_MONOTONIC, &end);
+        latencies[i] = elapsed_us(start, end);
+    }
+
+    timespec cpu_end{};
+    timespec wall_end{};
+    (void) clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpu_end);
+    (void) clock_gettime(CLOCK_MONOTONIC, &wall_end);
+
+    std::sort(latencies.begin(), latencies.end());
+    result->p50_us = latencies[latencies.size() / 2];
+    result->p99_us = latencies[(latencies.size() * 99) / 100];
+    result->snapshots_per_second = snapshots / (elapsed_us(wall_start, wall_end) / 1e6);
+    // CPU of reading one snapshot per analyser tick for a second
+    result->cpu_ms_per_second = elapsed_us(cpu_start, cpu_end) / snapshots * TICK_RATE / 1e3;
+    return true;
+}
+
+/**
+ * Check that every strategy reads the same values
+ */
+bool strategies_agree(const Reader &reader, const Layout &layout, const Strategy *strategies, const size_t count) {
+    std::vector<uint32_t> expected(layout.addresses.size());
+    std::vector<uint32_t> values(layout.addresses.size());
+    if (strategies[0].read(reader, layout, expected.data()) < 0) {
+        return false;
+    }
+
+    for (size_t i = 1; i < count; i++) {
+        if (strategies[i].read(reader, layout, values.data()) < 0 || values != expected) { // NOLINT
+            (void) fprintf(stderr, "%s: %s read different values\n", layout.name.c_str(), strategies[i].name); // NOLINT
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(const int argc, const char **argv) {
+    const int snapshots = argc > 1 ? atoi(argv[1]) : DEFAULT_SNAPSHOTS; // NOLINT
+    if (snapshots <= 0) {
+        (void) fprintf(stderr, "usage: %s [snapshots]\n", argv[0]); // NOLINT
+        return 1;
+    }
+
+    // Static memory, every strategy must read the same values
+    const FakeEmulator emulator("0", "left");
+    if (!emulator.ready()) {
+        (void) fprintf(stderr, "failed to start the fake emulator\n");
+        return EXIT_SKIP;
+    }
+
+    const std::string mem_path = "/proc/" + std::to_string(emulator.pid()) + "/mem";
+    Reader reader = {.pid = emulator.pid(),
+                     .mem_fd = open(mem_path.c_str(), O_RDONLY | O_CLOEXEC),
+                     .mapping = map_guest_memory(emulator.pid())};
+    if (reader.mem_fd < 0 || reader.mapping == nullptr) {
+        (void) fprintf(stderr, "cannot access the fake emulator's memory: %s\n", strerror(errno));
+        return EXIT_SKIP;
+    }
+
+    const Strategy strategies[] = {{.name = "per-field", .read = &read_per_field},
+                                   {.name = "vectored", .read = &read_vectored},
+                                   {.name = "proc-mem", .read = &read_proc_mem},
+                                   {.name = "direct", .read = &read_direct}};
+
+    std::vector<Layout> layouts = {game_layout(reader)};
+    for (const size_t fields : {8, 32, 128}) {
+        for (const uint64_t spread : {4, 4096, 1 << 20}) {
+            layouts.push_back(synthetic_layout(fields, spread));
+        }
+    }
+
+    int status = 0;
+    (void) printf("%-16s %-10s %9s %9s %9s %12s %14s\n",
+                  "layout",
+                  "strategy",
+                  "syscalls",
+                  "p50 us",
+                  "p99 us",
+                  "snapshots/s",
+                  "cpu ms/s@120Hz");
+    for (const Layout &layout : layouts) {
+        if (!strategies_agree(reader, layout, strategies, std::size(strategies))) {
+            status = 1;
+            continue;
+        }
+
+        for (const Strategy &strategy : strategies) {
+            Result result = {};
+            if (!run_strategy(reader, layout, strategy, snapshots, &result)) {
+                (void) fprintf(stderr, "%s: %s failed\n", layout.name.c_str(), strategy.name);
+                status = 1;
+                continue;
+            }
+            (void) printf("%-16s %-10s %9d %9.2f %9.2f %12.0f %14.3f\n",
+                          layout.name.c_str(),
+                          strategy.name,
+                          result.syscalls,
+                          result.p50_us,
+                          result.p99_us,
+                          result.snapshots_per_second,
+                          result.cpu_ms_per_second);
+        }
+    }
+
+    munmap((void *) reader.mapping, FAKE_GUEST_MEMORY_SIZE); // NOLINT
+    close(reader.mem_fd);
+    return status;
+}
@@ -0,0 +1,273 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+// Headless overlay render benchmark
+//
+// Renders the overlay into an offscreen framebuffer of an EGL surfaceless
+// context, so it runs on software GL (llvmpipe) without a display. Fails
+// if the renderer allocates with operator new during the measured frames,
+// allocations of the GL driver are only reported.
+//
+// Usage: render_bench [frames]
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+
+#include <glad/gl.h> // NOLINT
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include "gui_constants.hpp"
+#include "renderer.hpp"
+
+#include "counting_allocator.hpp"
+
+// Constants
+#define DEFAULT_FRAMES 1000
+#define WARMUP_FRAMES 10
+// Text and timeline, fails the run if exceeded
+#define DRAW_CALL_BUDGET 2
+#define EXIT_SKIP 77
+
+namespace {
+
+enum class Scenario : uint8_t {
+    NO_GAME,
+    STATIC,
+    CHANGING
+};
+
+struct BenchResult {
+    double cpu_us;
+    double wall_us;
+    int max_draw_calls;
+    double uploads;
+    // Operator new allocations of the renderer, fails the run if any
+    size_t cpp_allocations;
+    // Heap allocations including the GL driver's
+    double allocations;
+};
+
+struct Offscreen {
+    EGLDisplay display;
+    EGLContext context;
+    unsigned int framebuffer;
+    unsigned int renderbuffer;
+};
+
+double elapsed_us(const timespec &start, const timespec &end) {
+    return ((double) (end.tv_sec - start.tv_sec) * 1e6) + ((double) (end.tv_nsec - start.tv_nsec) / 1e3);
+}
+
+EGLDisplay get_display() {
+    auto get_platform_display =
+        (PFNEGLGETPLATFORMDISPLAYEXTPROC) eglGetProcAddress("eglGetPlatformDisplayEXT"); // NOLINT
+    if (get_platform_display != nullptr) {
+        EGLDisplay display = get_platform_display(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+        if (display != EGL_NO_DISPLAY) {
+            return display;
+        }
+    }
+    return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+
+bool create_offscreen(Offscreen *offscreen) {
+    offscreen->display = get_display();
+    if (offscreen->display == EGL_NO_DISPLAY || eglInitialize(offscreen->display, nullptr, nullptr) == EGL_FALSE) {
+        (void) fprintf(stderr, "no EGL display\n");
+        return false;
+    }
+
+    if (eglBindAPI(EGL_OPENGL_API) == EGL_FALSE) {
+        (void) fprintf(stderr, "EGL has no desktop OpenGL\n");
+        return false;
+    }
+
+    // Same context version as the GUI
+    const EGLint context_attributes[] = {EGL_CONTEXT_MAJOR_VERSION,
+                                         3,
+                                         EGL_CONTEXT_MINOR_VERSION,
+                                         3,
+                                         EGL_CONTEXT_OPENGL_PROFILE_MASK,
+                                         EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+                                         EGL_NONE};
+    offscreen->context = eglCreateContext(offscreen->display, nullptr, EGL_NO_CONTEXT, context_attributes);
+    if (offscreen->context == EGL_NO_CONTEXT ||
+        eglMakeCurrent(offscreen->display, EGL_NO_SURFACE, EGL_NO_SURFACE, offscreen->context) == EGL_FALSE) {
+        (void) fprintf(stderr, "failed to create surfaceless OpenGL 3.3 context\n");
+        return false;
+    }
+
+    if (gladLoadGL((GLADloadfunc) eglGetProcAddress) == 0) { // NOLINT
+        (void) fprintf(stderr, "failed to load glad GL\n");
+        return false;
+    }
+
+    // Render target of the overlay size
+    glGenRenderbuffers(1, &offscreen->renderbuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, offscreen->renderbuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, MAX_WIDTH, MAX_HEIGTH);
+
+    glGenFramebuffers(1, &offscreen->framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, offscreen->framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, offscreen->renderbuffer);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        (void) fprintf(stderr, "offscreen framebuffer is incomplete\n");
+        return false;
+    }
+    glViewport(0, 0, MAX_WIDTH, MAX_HEIGTH);
+
+    (void) printf("renderer: %s, %s\n", glGetString(GL_RENDERER), glGetString(GL_VERSION));
+    return true;
+}
+
+void destroy_offscreen(Offscreen *offscreen) {
+    glDeleteFramebuffers(1, &offscreen->framebuffer);
+    glDeleteRenderbuffers(1, &offscreen->renderbuffer);
+    eglMakeCurrent(offscreen->display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    eglDestroyContext(offscreen->display, offscreen->context);
+    eglTerminate(offscreen->display);
+}
+
+OverlayState scenario_state(const Scenario scenario, const int frame) {
+    OverlayState state = {.game_hooked = scenario != Scenario::NO_GAME,
+                          .frame_data_valid = true,
+                          .data_point = {.startup_frames = 13, .frame_advantage = -4, .knock_down = false},
+                          .distance = 2.5F,
+                          .status = PlayerState::STANDING};
+
+    if (scenario == Scenario::CHANGING) {
+        // New frame data and distance on every frame
+        state.data_point.frame_advantage = (frame % 21) - 10;
+        state.data_point.startup_frames = 10 + (frame % 7);
+        state.distance = 1.0F + ((float) (frame % 300) / 100.0F);
+        renderer_push_timeline_samples(TIMELINE_ADVANTAGE, (float) state.data_point.frame_advantage, 1);
+        renderer_push_timeline_samples(TIMELINE_DISTANCE, state.distance, 1);
+    }
+
+    return state;
+}
+
+BenchResult run_scenario(const Scenario scenario, const int frames) {
+    for (int frame = 0; frame < WARMUP_FRAMES; frame++) {
+        renderer_draw(scenario_state(scenario, frame));
+        glFinish();
+    }
+
+    BenchResult result = {};
+    double uploads = 0;
+    timespec cpu_start{};
+    timespec wall_start{};
+    (void) clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpu_start);
+    (void) clock_gettime(CLOCK_MONOTONIC, &wall_start);
+    counting_allocator_arm();
+
+    for (int frame = 0; frame < frames; frame++) {
+        renderer_draw(scenario_state(scenario, frame));
+        // Include the GL work, llvmpipe runs it on this process' threads
+        glFinish();
+
+        const RenderStats stats = renderer_stats();
+        if (stats.draw_calls > result.max_draw_calls) {
+            result.max_draw_calls = stats.draw_calls;
+        }
+        uploads += stats.buffer_uploads;
+    }
+
+    const AllocationCounts counts = counting_allocator_disarm();
+    timespec cpu_end{};
+    timespec wall_end{};
+    (void) clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpu_end);
+    (void) clock_gettime(CLOCK_MONOTONIC, &wall_end);
+
+    result.cpu_us = elapsed_us(cpu_start, cpu_end) / frames;
+    result.wall_us = elapsed_us(wall_start, wall_end) / frames;
+    result.uploads = uploads / frames;
+    result.cpp_allocations = counts.cpp;
+    result.allocations = (double) counts.total / frames;
+    return result;
+}
+
+} // namespace
+
+int main(const int argc, const char **argv) {
+    const int frames = argc > 1 ? atoi(argv[1]) : DEFAULT_FRAMES; // NOLINT
+    if (frames <= 0) {
+        (void) fprintf(stderr, "usage: %s [frames]\n", argv[0]); // NOLINT
+        return 1;
+    }
+
+    counting_allocator_track_thread();
+
+    Offscreen offscreen = {};
+    if (!create_offscreen(&offscreen)) {
+        return EXIT_SKIP;
+    }
+
+    if (!renderer_init()) {
+        (void) fprintf(stderr, "failed to initialize renderer\n");
+        destroy_offscreen(&offscreen);
+        return 1;
+    }
+
+    const struct {
+        Scenario scenario;
+        const char *name;
+    } scenarios[] = {{Scenario::NO_GAME, "no game"}, {Scenario::STATIC, "static"}, {Scenario::CHANGING, "changing"}};
+
+    int status = 0;
+    (void) printf("%-10s %14s %14s %12s %16s %16s\n",
+                  "scenario",
+                  "cpu us/frame",
+                  "wall us/frame",
+                  "draw calls",
+                  "uploads/frame",
+                  "allocs/frame");
+    for (const auto &entry : scenarios) {
+        const BenchResult result = run_scenario(entry.scenario, frames);
+        (void) printf("%-10s %14.1f %14.1f %12d %16.2f %16.2f\n",
+                      entry.name,
+                      result.cpu_us,
+                      result.wall_us,
+                      result.max_draw_calls,
+                      result.uploads,
+                      result.allocations);
+
+        if (result.max_draw_calls > DRAW_CALL_BUDGET) {
+            (void) fprintf(stderr, "%s: %d draw calls exceed the budget of %d\n", entry.name, result.max_draw_calls,
+                           DRAW_CALL_BUDGET);
+            status = 1;
+        }
+
+        if (result.cpp_allocations > 0) {
+            (void) fprintf(stderr, "%s: renderer allocated %zu times in steady-state frames\n", entry.name,
+                           result.cpp_allocations);
+            status = 1;
+        }
+    }
+
+    const GLenum error = glGetError();
+    if (error != GL_NO_ERROR) {
+        (void) fprintf(stderr, "GL error 0x%x\n", error);
+        status = 1;
+    }
+
+    destroy_offscreen(&offscreen);
+    return status;
+}
@@ -0,0 +1,86 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+
+#include "frame_data_analyser.hpp"
+#include "logging.h"
+#include "shadow_analyser.hpp"
+#include "synthetic_frames.hpp"
+
+#define ROUNDS 4
+
+namespace {
+class NullListener : public EventListener {
+public:
+    void tick(const TickEvents & /*events*/) override {}
+};
+
+NullListener g_listener;
+
+/**
+ * Run the scenario through the reference analyser with the candidate shadowing it
+ */
+void run_session(const Scenario scenario) {
+    FrameDataAnalyser::reset(&g_listener);
+
+    const std::vector<GameFrame> frames = scenario_frames(scenario);
+    FrameDataAnalyser::push_frame(frames[0]);
+    ShadowAnalyser::seed(frames[0]);
+
+    for (int round = 0; round < ROUNDS; round++) {
+        for (size_t i = round == 0 ? 1 : 0; i < frames.size(); i++) {
+            GameFrame frame = frames[i];
+            frame.game_frame += (uint32_t) (round * SCENARIO_PERIOD);
+            FrameDataAnalyser::process_frame(frame);
+        }
+    }
+}
+} // namespace
+
+TEST(ShadowAnalyser, RejectsMissingModule) {
+    log_set_quiet(true);
+    EXPECT_FALSE(ShadowAnalyser::start("/nonexistent/shadow_candidate.so"));
+    EXPECT_FALSE(ShadowAnalyser::enabled());
+    log_set_quiet(false);
+}
+
+TEST(ShadowAnalyser, SameAnalyserDoesNotDiverge) {
+    ASSERT_TRUE(ShadowAnalyser::start(SHADOW_CANDIDATE_PATH));
+    for (const Scenario scenario : {Scenario::SINGLE_HIT, Scenario::NATURAL_STRING, Scenario::MULTI_HIT}) {
+        run_session(scenario);
+    }
+    ShadowAnalyser::stop();
+
+    EXPECT_EQ(ShadowAnalyser::divergences(), 0);
+}
+
+TEST(ShadowAnalyser, ReportsDivergence) {
+    ASSERT_TRUE(ShadowAnalyser::start(SHADOW_CANDIDATE_PATH));
+    const std::vector<GameFrame> frames = scenario_frames(Scenario::SINGLE_HIT);
+    ShadowAnalyser::seed(frames[0]);
+
+    // Frame data the candidate does not produce for the second frame
+    TickEvents events = {};
+    events.changed = TICK_FRAME_DATA;
+    events.frame_data = {.startup_frames = 99, .frame_advantage = 0, .knock_down = false};
+    ShadowAnalyser::add_events(events);
+    ShadowAnalyser::record(frames[1], 0);
+    ShadowAnalyser::stop();
+
+    EXPECT_EQ(ShadowAnalyser::divergences(), 1);
+}
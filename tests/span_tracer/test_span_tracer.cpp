@@ -0,0 +1,121 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+#include <thread>
+
+#include <unistd.h>
+
+#include "logging.h"
+#include "span_tracer.hpp"
+
+namespace {
+std::string read_file(const char *path) {
+    std::string text;
+    FILE *file = fopen(path, "r");
+    if (file == nullptr) {
+        return text;
+    }
+
+    char buffer[4096];
+    size_t read = 0;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        text.append(buffer, read);
+    }
+    (void) fclose(file);
+    return text;
+}
+
+size_t count(const std::string &text, const std::string &pattern) {
+    size_t found = 0;
+    for (size_t position = text.find(pattern); position != std::string::npos;
+         position = text.find(pattern, position + 1)) {
+        found++;
+    }
+    return found;
+}
+} // namespace
+
+TEST(test_span_tracer, disabled_records_nothing) {
+    EXPECT_FALSE(SpanTracer::enabled());
+    {
+        TRACE_SCOPE("not recorded");
+    }
+}
+
+TEST(test_span_tracer, writes_chrome_trace) {
+    log_set_quiet(true);
+    char path[] = "/tmp/test_span_tracer_XXXXXX";
+    const int fd = mkstemp(path);
+    ASSERT_NE(fd, -1);
+    (void) close(fd);
+
+    ASSERT_TRUE(SpanTracer::start(path));
+    SpanTracer::set_thread_name("main");
+    {
+        TRACE_SCOPE("outer");
+        TRACE_SCOPE("inner");
+    }
+
+    std::thread worker([] {
+        SpanTracer::set_thread_name("worker");
+        for (int i = 0; i < 3; i++) {
+            TRACE_SCOPE("work");
+        }
+    });
+    worker.join();
+    SpanTracer::stop();
+    log_set_quiet(false);
+
+    const std::string trace = read_file(path);
+    (void) remove(path);
+
+    EXPECT_EQ(trace.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0), 0);
+    EXPECT_EQ(count(trace, "\"ph\":\"M\""), 2);
+    EXPECT_EQ(count(trace, "\"name\":\"outer\""), 1);
+    EXPECT_EQ(count(trace, "\"name\":\"inner\""), 1);
+    EXPECT_EQ(count(trace, "\"name\":\"work\""), 3);
+    EXPECT_EQ(count(trace, "\"args\":{\"name\":\"worker\"}"), 1);
+    EXPECT_NE(trace.find("]}"), std::string::npos);
+}
+
+TEST(test_span_tracer, full_ring_keeps_newest_spans) {
+    log_set_quiet(true);
+    char path[] = "/tmp/test_span_tracer_XXXXXX";
+    const int fd = mkstemp(path);
+    ASSERT_NE(fd, -1);
+    (void) close(fd);
+
+    ASSERT_TRUE(SpanTracer::start(path));
+    std::thread worker([] {
+        for (int i = 0; i < SPAN_BUFFER_SIZE + 100; i++) {
+            SpanTracer::record(i < 100 ? "old" : "new", i, i + 1);
+        }
+    });
+    worker.join();
+    SpanTracer::stop();
+    log_set_quiet(false);
+
+    const std::string trace = read_file(path);
+    (void) remove(path);
+
+    EXPECT_EQ(count(trace, "\"name\":\"old\""), 0);
+    EXPECT_EQ(count(trace, "\"name\":\"new\""), SPAN_BUFFER_SIZE * 3 / 4);
+}
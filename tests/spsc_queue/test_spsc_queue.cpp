@@ -0,0 +1,91 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "spsc_queue.hpp"
+
+#define QUEUE_SIZE 5
+#define THREADED_QUEUE_SIZE 64
+#define THREADED_ITEMS 100000
+
+TEST(test_spsc_queue, capacity_rounded_up) {
+    SpscQueue<int> queue(QUEUE_SIZE);
+    ASSERT_EQ(8, queue.capacity());
+    ASSERT_TRUE(queue.empty());
+}
+
+TEST(test_spsc_queue, push_pop_order) {
+    SpscQueue<int> queue(QUEUE_SIZE);
+    int value = 0;
+
+    ASSERT_FALSE(queue.pop(value));
+    for (int i = 0; i < 8; i++) {
+        ASSERT_TRUE(queue.push(i));
+    }
+
+    // Full
+    ASSERT_FALSE(queue.push(8));
+
+    for (int i = 0; i < 8; i++) {
+        ASSERT_TRUE(queue.pop(value));
+        ASSERT_EQ(i, value);
+    }
+    ASSERT_FALSE(queue.pop(value));
+    ASSERT_TRUE(queue.empty());
+}
+
+TEST(test_spsc_queue, wrap_around) {
+    SpscQueue<int> queue(QUEUE_SIZE);
+    int value = 0;
+
+    for (int i = 0; i < 100; i++) {
+        ASSERT_TRUE(queue.push(i));
+        ASSERT_TRUE(queue.push(i + 1000));
+        ASSERT_TRUE(queue.pop(value));
+        ASSERT_EQ(i, value);
+        ASSERT_TRUE(queue.pop(value));
+        ASSERT_EQ(i + 1000, value);
+    }
+}
+
+TEST(test_spsc_queue, threaded) {
+    SpscQueue<int> queue(THREADED_QUEUE_SIZE);
+
+    std::thread producer([&queue]() {
+        for (int i = 0; i < THREADED_ITEMS; i++) {
+            while (!queue.push(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    int expected = 0;
+    int value = 0;
+    while (expected < THREADED_ITEMS) {
+        if (!queue.pop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        ASSERT_EQ(expected, value);
+        expected++;
+    }
+
+    producer.join();
+}
@@ -0,0 +1,159 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "latency_histogram.h"
+#include "logging.h"
+#include "perf_counters.hpp"
+#include "tick_profiler.hpp"
+
+TEST(test_latency_histogram, empty) {
+    LatencyHistogram histogram{};
+    latency_histogram_clear(&histogram);
+
+    EXPECT_EQ(latency_histogram_count(&histogram), 0);
+    EXPECT_EQ(latency_histogram_percentile(&histogram, 50), 0);
+    EXPECT_EQ(latency_histogram_max(&histogram), 0);
+}
+
+TEST(test_latency_histogram, small_values_are_exact) {
+    LatencyHistogram histogram{};
+    latency_histogram_clear(&histogram);
+    for (uint64_t ns = 0; ns < 8; ns++) {
+        latency_histogram_record(&histogram, ns);
+    }
+
+    EXPECT_EQ(latency_histogram_count(&histogram), 8);
+    EXPECT_EQ(latency_histogram_percentile(&histogram, 50), 3);
+    EXPECT_EQ(latency_histogram_percentile(&histogram, 100), 7);
+}
+
+TEST(test_latency_histogram, percentiles_within_bucket_error) {
+    LatencyHistogram histogram{};
+    latency_histogram_clear(&histogram);
+    // 1..1000 us
+    for (uint64_t us = 1; us <= 1000; us++) {
+        latency_histogram_record(&histogram, us * 1000);
+    }
+
+    const double p50 = (double) latency_histogram_percentile(&histogram, 50);
+    const double p99 = (double) latency_histogram_percentile(&histogram, 99);
+    EXPECT_GE(p50, 500000.0);
+    EXPECT_LE(p50, 500000.0 * 1.125);
+    EXPECT_GE(p99, 990000.0);
+    EXPECT_LE(p99, 1000000.0);
+    EXPECT_EQ(latency_histogram_max(&histogram), 1000000);
+}
+
+TEST(test_latency_histogram, huge_values_saturate) {
+    LatencyHistogram histogram{};
+    latency_histogram_clear(&histogram);
+    latency_histogram_record(&histogram, UINT64_MAX);
+
+    EXPECT_EQ(latency_histogram_count(&histogram), 1);
+    EXPECT_EQ(latency_histogram_percentile(&histogram, 50), UINT64_MAX);
+}
+
+TEST(test_tick_profiler, stages_and_deadline_misses) {
+    log_set_quiet(true);
+    // 1 ms deadline
+    TickProfiler::enable(1000000);
+
+    for (int tick = 0; tick < 4; tick++) {
+        TickProfiler::begin_tick();
+        TickProfiler::mark(TickStage::SYNC);
+        // Marked twice, both laps are summed
+        TickProfiler::mark(TickStage::PUBLISH);
+        if (tick == 3) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+        TickProfiler::mark(TickStage::STRINGS);
+        TickProfiler::mark(TickStage::PUBLISH);
+        TickProfiler::end_tick();
+    }
+
+    EXPECT_EQ(latency_histogram_count(&TickProfiler::histogram(TickStage::SYNC)), 4);
+    EXPECT_EQ(latency_histogram_count(&TickProfiler::histogram(TickStage::PUBLISH)), 4);
+    EXPECT_EQ(latency_histogram_count(&TickProfiler::histogram(TickStage::READ)), 0);
+    EXPECT_GE(latency_histogram_max(&TickProfiler::histogram(TickStage::STRINGS)), 2000000);
+    EXPECT_EQ(TickProfiler::deadline_misses(), 1);
+
+    TickProfiler::log_summary();
+    log_set_quiet(false);
+}
+
+TEST(test_tick_profiler, untouched_sync_is_not_blamed) {
+    log_set_quiet(true);
+    TickProfiler::enable(1000000);
+    const uint32_t sync_misses = TickProfiler::stage_misses(TickStage::SYNC);
+    const uint32_t strings_misses = TickProfiler::stage_misses(TickStage::STRINGS);
+    const uint64_t misses = TickProfiler::deadline_misses();
+
+    // Missed tick which never marks the sync stage
+    TickProfiler::begin_tick();
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    TickProfiler::mark(TickStage::STRINGS);
+    TickProfiler::end_tick();
+
+    // Missed tick without marks
+    TickProfiler::begin_tick();
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    TickProfiler::end_tick();
+
+    EXPECT_EQ(TickProfiler::deadline_misses(), misses + 2);
+    EXPECT_EQ(TickProfiler::stage_misses(TickStage::STRINGS), strings_misses + 1);
+    EXPECT_EQ(TickProfiler::stage_misses(TickStage::SYNC), sync_misses);
+    log_set_quiet(false);
+}
+
+TEST(test_perf_counters, software_counters_per_stage) {
+    log_set_quiet(true);
+    PerfCounters::enable();
+    const bool attached = PerfCounters::attach_thread();
+    log_set_quiet(false);
+    if (!attached) {
+        GTEST_SKIP() << "perf_event_open is not permitted";
+    }
+
+    PerfCounters::begin();
+    // Fault in fresh pages and give up the CPU
+    std::vector<char> memory(16 * 1024 * 1024);
+    memset(memory.data(), 1, memory.size());
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    PerfCounters::lap(1);
+    PerfCounters::lap(2);
+
+    EXPECT_EQ(PerfCounters::stage_laps(0), 0);
+    EXPECT_EQ(PerfCounters::stage_laps(1), 1);
+    EXPECT_GT(PerfCounters::stage_total(1).values[PERF_PAGE_FAULTS], 0);
+    // From getrusage when kernel events are not permitted
+    EXPECT_GT(PerfCounters::stage_total(1).values[PERF_CONTEXT_SWITCHES], 0);
+    if (!PerfCounters::kernel_counted()) {
+        EXPECT_EQ(PerfCounters::stage_total(1).values[PERF_CPU_MIGRATIONS], 0);
+    }
+    EXPECT_LE(PerfCounters::stage_total(2).values[PERF_PAGE_FAULTS],
+              PerfCounters::stage_total(1).values[PERF_PAGE_FAULTS]);
+    if (PerfCounters::hardware_available()) {
+        EXPECT_GT(PerfCounters::stage_total(1).values[PERF_INSTRUCTIONS], 0);
+    }
+}
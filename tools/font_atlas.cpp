@@ -0,0 +1,218 @@
+/*
+  Copyright (C) 2025 Noa-Emil Nissinen
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.    See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.    If not, see <https://www.gnu.org/licenses/>.
+*/
+
+// Build-time generator for the signed distance field font atlas of the GUI
+//
+// Usage: font_atlas <font.ttf> <output.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include <ft2build.h> // NOLINT
+#include FT_FREETYPE_H
+#include FT_MODULE_H
+
+// Constants
+#define FONT_CHARS 128
+// Glyphs are rendered at this size, the GUI scales them to FONT_SIZE
+#define GLYPH_SIZE 32
+// Distance in pixels covered by the field around the glyph outline
+#define SDF_SPREAD 4
+#define ATLAS_WIDTH 512
+// Padding between glyphs to avoid bleeding with linear filtering
+#define ATLAS_PADDING 1
+
+namespace {
+
+struct Glyph {
+    int x;
+    int y;
+    int width;
+    int height;
+    int bearing_x;
+    int bearing_y;
+    int advance;
+    std::vector<unsigned char> bitmap;
+};
+
+bool render_glyphs(FT_Face face, Glyph *glyphs) {
+    for (int c = 0; c < FONT_CHARS; c++) {
+        Glyph &glyph = glyphs[c]; // NOLINT
+        glyph = {};
+
+        if (FT_Load_Char(face, c, FT_LOAD_DEFAULT) != 0) { // NOLINT
+            continue;
+        }
+
+        const FT_GlyphSlot slot = face->glyph;
+        glyph.advance = (int) (slot->advance.x >> 6); // NOLINT
+
+        // Empty glyphs such as space have only an advance
+        if (slot->outline.n_points == 0) {
+            continue;
+        }
+
+        if (FT_Render_Glyph(slot, FT_RENDER_MODE_SDF) != 0) {
+            (void) fprintf(stderr, "failed to render glyph %d\n", c);
+            return false;
+        }
+
+        const FT_Bitmap &bitmap = slot->bitmap;
+        glyph.width = (int) bitmap.width;
+        glyph.height = (int) bitmap.rows;
+        glyph.bearing_x = slot->bitmap_left;
+        glyph.bearing_y = slot->bitmap_top;
+        glyph.bitmap.resize((size_t) glyph.width * glyph.height);
+
+        for (int row = 0; row < glyph.height; row++) {
+            memcpy(&glyph.bitmap[(size_t) row * glyph.width], // NOLINT
+                   &bitmap.buffer[row * bitmap.pitch], // NOLINT
+                   glyph.width);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Pack glyphs row by row
+ *
+ * @return atlas height
+ */
+int pack_glyphs(Glyph *glyphs) {
+    int pen_x = 0;
+    int pen_y = 0;
+    int row_height = 0;
+
+    for (int c = 0; c < FONT_CHARS; c++) {
+        Glyph &glyph = glyphs[c]; // NOLINT
+        if (pen_x + glyph.width > ATLAS_WIDTH) {
+            pen_x = 0;
+            pen_y += row_height + ATLAS_PADDING;
+            row_height = 0;
+        }
+
+        glyph.x = pen_x;
+        glyph.y = pen_y;
+        pen_x += glyph.width + ATLAS_PADDING;
+        row_height = std::max(row_height, glyph.height);
+    }
+
+    return pen_y + row_height;
+}
+
+void write_header(FILE *output, const Glyph *glyphs, const int height) {
+    std::vector<unsigned char> atlas((size_t) ATLAS_WIDTH * height, 0);
+    for (int c = 0; c < FONT_CHARS; c++) {
+        const Glyph &glyph = glyphs[c]; // NOLINT
+        for (int row = 0; row < glyph.height; row++) {
+            memcpy(&atlas[((size_t) (glyph.y + row) * ATLAS_WIDTH) + glyph.x], // NOLINT
+                   &glyph.bitmap[(size_t) row * glyph.width], // NOLINT
+                   glyph.width);
+        }
+    }
+
+    (void) fprintf(output,
+                   "// Generated by tools/font_atlas.cpp, do not edit\n"
+                   "#ifndef FONT_ATLAS_H\n"
+                   "#define FONT_ATLAS_H\n\n"
+                   "#define FONT_ATLAS_CHARS %d\n"
+                   "#define FONT_ATLAS_GLYPH_SIZE %d\n"
+                   "#define FONT_ATLAS_SPREAD %d\n"
+                   "#define FONT_ATLAS_WIDTH %d\n"
+                   "#define FONT_ATLAS_HEIGHT %d\n\n"
+                   "// Glyph metrics in pixels at FONT_ATLAS_GLYPH_SIZE\n"
+                   "struct FontAtlasGlyph {\n"
+                   "    int x, y, width, height, bearing_x, bearing_y, advance;\n"
+                   "};\n\n"
+                   "static const struct FontAtlasGlyph font_atlas_glyphs[FONT_ATLAS_CHARS] = {\n",
+                   FONT_CHARS,
+                   GLYPH_SIZE,
+                   SDF_SPREAD,
+                   ATLAS_WIDTH,
+                   height);
+
+    for (int c = 0; c < FONT_CHARS; c++) {
+        const Glyph &glyph = glyphs[c]; // NOLINT
+        (void) fprintf(output,
+                       "    {%d, %d, %d, %d, %d, %d, %d},\n",
+                       glyph.x,
+                       glyph.y,
+                       glyph.width,
+                       glyph.height,
+                       glyph.bearing_x,
+                       glyph.bearing_y,
+                       glyph.advance);
+    }
+
+    (void) fprintf(output, "};\n\nstatic const unsigned char font_atlas_data[FONT_ATLAS_WIDTH * FONT_ATLAS_HEIGHT] = {");
+    for (size_t i = 0; i < atlas.size(); i++) {
+        (void) fprintf(output, "%s%u,", i % 16 == 0 ? "\n    " : " ", atlas[i]);
+    }
+    (void) fprintf(output, "\n};\n\n#endif\n");
+}
+
+} // namespace
+
+int main(const int argc, const char **argv) {
+    if (argc != 3) {
+        (void) fprintf(stderr, "usage: %s <font.ttf> <output.h>\n", argv[0]); // NOLINT
+        return 1;
+    }
+
+    FT_Library ft = nullptr;
+    if (FT_Init_FreeType(&ft) != 0) {
+        (void) fprintf(stderr, "failed to initialize FreeType\n");
+        return 1;
+    }
+
+    const FT_Int spread = SDF_SPREAD;
+    FT_Property_Set(ft, "sdf", "spread", &spread);
+
+    FT_Face face = nullptr;
+    if (FT_New_Face(ft, argv[1], 0, &face) != 0) { // NOLINT
+        (void) fprintf(stderr, "failed to load font %s\n", argv[1]); // NOLINT
+        FT_Done_FreeType(ft);
+        return 1;
+    }
+
+    FT_Set_Pixel_Sizes(face, 0, GLYPH_SIZE);
+
+    static Glyph glyphs[FONT_CHARS];
+    const bool rendered = render_glyphs(face, glyphs);
+    FT_Done_Face(face);
+    FT_Done_FreeType(ft);
+
+    if (!rendered) {
+        return 1;
+    }
+
+    const int height = pack_glyphs(glyphs);
+
+    FILE *output = fopen(argv[2], "w"); // NOLINT
+    if (output == nullptr) {
+        (void) fprintf(stderr, "failed to open %s\n", argv[2]); // NOLINT
+        return 1;
+    }
+
+    write_header(output, glyphs, height);
+    (void) fclose(output);
+
+    return 0;
+}